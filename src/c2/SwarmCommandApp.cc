@@ -0,0 +1,142 @@
+//===================================================================================
+// SWARM COMMAND APP - GCS command/control uplink
+//===================================================================================
+
+#include "c2/SwarmCommandApp.h"
+
+#include "inet/common/Simsignals.h"
+#include "inet/common/ModuleAccess.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmCommandApp);
+
+SwarmCommandApp::~SwarmCommandApp()
+{
+    cancelAndDelete(selfMsg);
+}
+
+void SwarmCommandApp::initialize(int stage)
+{
+    ApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        destPort = par("destPort");
+        startTime = par("startTime");
+        stopTime = par("stopTime");
+        if (stopTime >= SIMTIME_ZERO && stopTime < startTime)
+            throw cRuntimeError("Invalid startTime/stopTime parameters");
+        waypointProbability = par("waypointProbability");
+        recallProbability = par("recallProbability");
+        if (waypointProbability < 0 || recallProbability < 0 || waypointProbability + recallProbability > 1)
+            throw cRuntimeError("Invalid waypointProbability/recallProbability parameters");
+        selfMsg = new cMessage("CommandTimer");
+    }
+}
+
+void SwarmCommandApp::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg->isSelfMessage()) {
+        switch (msg->getKind()) {
+            case START:
+            case SEND:
+                sendCommands();
+                scheduleNextSend();
+                break;
+            case STOP:
+                break;
+            default:
+                throw cRuntimeError("Invalid kind %d in self message", (int)msg->getKind());
+        }
+    }
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmCommandApp::scheduleNextSend()
+{
+    simtime_t next = simTime() + par("sendInterval");
+    if (stopTime < SIMTIME_ZERO || next < stopTime) {
+        selfMsg->setKind(SEND);
+        scheduleAt(next, selfMsg);
+    }
+    else {
+        selfMsg->setKind(STOP);
+        scheduleAt(stopTime, selfMsg);
+    }
+}
+
+void SwarmCommandApp::sendCommands()
+{
+    if (targets.empty())
+        return;
+    double draw = uniform(0, 1);
+    if (draw < recallProbability) {
+        // recall the whole swarm
+        for (int target = 0; target < (int)targets.size(); target++)
+            sendCommand(SWARM_COMMAND_RECALL, target, 0, Coord::ZERO);
+    }
+    else {
+        int target = intuniform(0, targets.size() - 1);
+        double areaSize = par("areaSize").doubleValue();
+        if (draw < recallProbability + waypointProbability) {
+            Coord waypoint(uniform(0, areaSize), uniform(0, areaSize), par("waypointAltitude").doubleValue());
+            sendCommand(SWARM_COMMAND_WAYPOINT, target, 0, waypoint);
+        }
+        else
+            sendCommand(SWARM_COMMAND_MISSION_CHANGE, target, intuniform(1, 100), Coord::ZERO);
+    }
+}
+
+void SwarmCommandApp::sendCommand(SwarmCommandType type, int target, uint16_t missionId, const Coord& waypoint)
+{
+    const auto& command = makeShared<SwarmCommand>();
+    command->setCommandId(commandId++);
+    command->setType(type);
+    command->setTarget(target);
+    command->setIssueTime(simTime());
+    command->setWaypoint(waypoint);
+    command->setMissionId(missionId);
+
+    auto packet = new Packet("SwarmCommand", command);
+    emit(packetSentSignal, packet);
+    socket.sendTo(packet, targets[target], destPort);
+}
+
+void SwarmCommandApp::handleStartOperation(LifecycleOperation *operation)
+{
+    // resolve every addressable drone once; the swarm size is fixed per run
+    const char *targetVector = par("targetVector");
+    cModule *network = getContainingNode(this)->getParentModule();
+    int numTargets = network->getSubmoduleVectorSize(targetVector);
+    targets.clear();
+    for (int i = 0; i < numTargets; i++)
+        targets.push_back(L3AddressResolver().resolve((std::string(targetVector) + "[" + std::to_string(i) + "]").c_str()));
+
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), par("localPort"));
+
+    simtime_t start = std::max(startTime, simTime());
+    if (stopTime < SIMTIME_ZERO || start < stopTime) {
+        selfMsg->setKind(START);
+        scheduleAt(start, selfMsg);
+    }
+}
+
+void SwarmCommandApp::handleStopOperation(LifecycleOperation *operation)
+{
+    cancelEvent(selfMsg);
+    socket.close();
+}
+
+void SwarmCommandApp::handleCrashOperation(LifecycleOperation *operation)
+{
+    cancelEvent(selfMsg);
+    socket.destroy();
+}
+
+} // namespace droneswarm
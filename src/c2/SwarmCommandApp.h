@@ -0,0 +1,64 @@
+//===================================================================================
+// SWARM COMMAND APP - GCS command/control uplink
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCOMMANDAPP_H
+#define __DRONESWARM_SWARMCOMMANDAPP_H
+
+#include <vector>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "c2/SwarmCommand_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmCommandApp : public ApplicationBase, public UdpSocket::ICallback
+{
+  protected:
+    enum SelfMsgKinds { START = 1, SEND, STOP };
+
+    // parameters
+    int destPort = -1;
+    simtime_t startTime;
+    simtime_t stopTime;
+    double waypointProbability = 0;
+    double recallProbability = 0;
+
+    // context
+    std::vector<L3Address> targets;     // index = drone index
+    UdpSocket socket;
+    cMessage *selfMsg = nullptr;
+
+    // state
+    uint32_t commandId = 0;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+
+    virtual void sendCommands();
+    void sendCommand(SwarmCommandType type, int target, uint16_t missionId, const Coord& waypoint);
+    void scheduleNextSend();
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override { delete packet; }
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override { delete indication; }
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmCommandApp();
+};
+
+} // namespace droneswarm
+
+#endif
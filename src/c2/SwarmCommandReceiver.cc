@@ -0,0 +1,59 @@
+//===================================================================================
+// SWARM COMMAND RECEIVER - Drone side of the C2 uplink
+//===================================================================================
+
+#include "c2/SwarmCommandReceiver.h"
+
+#include "inet/common/Simsignals.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmCommandReceiver);
+
+simsignal_t SwarmCommandReceiver::c2LatencySignal = cComponent::registerSignal("c2Latency");
+simsignal_t SwarmCommandReceiver::recallLatencySignal = cComponent::registerSignal("recallLatency");
+
+void SwarmCommandReceiver::handleMessageWhenUp(cMessage *msg)
+{
+    if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmCommandReceiver::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    emit(packetReceivedSignal, packet);
+    const auto& command = packet->peekAtFront<SwarmCommand>();
+    simtime_t latency = simTime() - command->getIssueTime();
+    emit(c2LatencySignal, latency);
+    if (command->getType() == SWARM_COMMAND_RECALL)
+        emit(recallLatencySignal, latency);
+    EV_INFO << "Command " << command->getCommandId() << " (type " << command->getType() << ") after " << latency << endl;
+    delete packet;
+}
+
+void SwarmCommandReceiver::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmCommandReceiver::handleStartOperation(LifecycleOperation *operation)
+{
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), par("localPort"));
+}
+
+void SwarmCommandReceiver::handleStopOperation(LifecycleOperation *operation)
+{
+    socket.close();
+}
+
+void SwarmCommandReceiver::handleCrashOperation(LifecycleOperation *operation)
+{
+    socket.destroy();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,42 @@
+//===================================================================================
+// SWARM COMMAND RECEIVER - Drone side of the C2 uplink
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCOMMANDRECEIVER_H
+#define __DRONESWARM_SWARMCOMMANDRECEIVER_H
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "c2/SwarmCommand_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmCommandReceiver : public ApplicationBase, public UdpSocket::ICallback
+{
+  protected:
+    UdpSocket socket;
+
+    static simsignal_t c2LatencySignal;
+    static simsignal_t recallLatencySignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+};
+
+} // namespace droneswarm
+
+#endif
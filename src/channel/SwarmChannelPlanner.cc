@@ -0,0 +1,181 @@
+//===================================================================================
+// SWARM CHANNEL PLANNER - Spatial channel assignment for multi-radio swarms
+//===================================================================================
+
+#include "channel/SwarmChannelPlanner.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace droneswarm {
+
+Define_Module(SwarmChannelPlanner);
+
+simsignal_t SwarmChannelPlanner::clusterSizeSignal = cComponent::registerSignal("clusterSize");
+simsignal_t SwarmChannelPlanner::channelSwitchesSignal = cComponent::registerSignal("channelSwitches");
+
+SwarmChannelPlanner::~SwarmChannelPlanner()
+{
+    cancelAndDelete(reassignTimer);
+}
+
+void SwarmChannelPlanner::initialize(int stage)
+{
+    cSimpleModule::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        channels = cStringTokenizer(par("channels")).asIntVector();
+        if (channels.empty())
+            throw cRuntimeError("No channels given");
+        hysteresis = par("hysteresis");
+        maxIterations = par("maxIterations");
+        reassignInterval = par("reassignInterval");
+
+        cModule *network = getParentModule();
+        const char *droneModule = par("droneModule");
+        const char *gcsModule = par("gcsModule");
+        for (int i = 0; i < network->getSubmoduleVectorSize(droneModule); i++)
+            drones.push_back(collectNode(network->getSubmodule(droneModule, i)));
+        for (int i = 0; i < network->getSubmoduleVectorSize(gcsModule); i++)
+            groundStations.push_back(collectNode(network->getSubmodule(gcsModule, i)));
+        reassignTimer = new cMessage("ChannelReassign");
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // radios and mobility are initialized, no frame is on the air yet
+        assign();
+        if (reassignInterval > SIMTIME_ZERO)
+            scheduleAfter(reassignInterval, reassignTimer);
+    }
+}
+
+void SwarmChannelPlanner::handleMessage(cMessage *msg)
+{
+    if (msg != reassignTimer)
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+    assign();
+    scheduleAfter(reassignInterval, reassignTimer);
+}
+
+SwarmChannelPlanner::Node SwarmChannelPlanner::collectNode(cModule *host) const
+{
+    Node node;
+    node.mobility = check_and_cast<IMobility *>(host->getSubmodule("mobility"));
+    for (int i = 0; i < host->getSubmoduleVectorSize("wlan"); i++)
+        node.radios.push_back(check_and_cast<physicallayer::Ieee80211Radio *>(host->getSubmodule("wlan", i)->getSubmodule("radio")));
+    node.tunedChannels.assign(node.radios.size(), -1);
+    return node;
+}
+
+Coord SwarmChannelPlanner::getGroundPosition(const Node& node)
+{
+    Coord position = node.mobility->getCurrentPosition();
+    position.z = 0;
+    return position;
+}
+
+void SwarmChannelPlanner::seedCentroids(const std::vector<Coord>& positions)
+{
+    // farthest-point seeding: spreads the first centroids over the swarm
+    int k = channels.size();
+    centroids.assign(1, positions.empty() ? Coord::ZERO : positions[0]);
+    while ((int)centroids.size() < k) {
+        Coord farthest = centroids.back();
+        double farthestDistance = -1;
+        for (const auto& position : positions) {
+            double d = INFINITY;
+            for (const auto& centroid : centroids)
+                d = std::min(d, position.distance(centroid));
+            if (d > farthestDistance) {
+                farthest = position;
+                farthestDistance = d;
+            }
+        }
+        centroids.push_back(farthest);
+    }
+}
+
+std::vector<int> SwarmChannelPlanner::getClustersByDistance(const Coord& position) const
+{
+    std::vector<int> order(centroids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&] (int a, int b) { return position.distance(centroids[a]) < position.distance(centroids[b]); });
+    return order;
+}
+
+void SwarmChannelPlanner::assign()
+{
+    int k = channels.size();
+    std::vector<Coord> positions;
+    for (const auto& drone : drones)
+        positions.push_back(getGroundPosition(drone));
+    if (centroids.empty())
+        seedCentroids(positions);
+
+    // Lloyd iterations, warm-started from the previous centroids
+    std::vector<int> labels(drones.size(), -1);
+    for (int iteration = 0; iteration < maxIterations; iteration++) {
+        bool changed = false;
+        for (size_t i = 0; i < positions.size(); i++) {
+            int nearest = getClustersByDistance(positions[i]).front();
+            if (nearest != labels[i]) {
+                labels[i] = nearest;
+                changed = true;
+            }
+        }
+        if (!changed)
+            break;
+        std::vector<Coord> sums(k, Coord::ZERO);
+        std::vector<int> counts(k, 0);
+        for (size_t i = 0; i < positions.size(); i++) {
+            sums[labels[i]] += positions[i];
+            counts[labels[i]]++;
+        }
+        for (int c = 0; c < k; c++)
+            if (counts[c] > 0)      // an empty cluster keeps its centroid
+                centroids[c] = sums[c] / counts[c];
+    }
+
+    int switches = 0;
+    std::vector<long> sizes(k, 0);
+    for (size_t i = 0; i < drones.size(); i++) {
+        Node& drone = drones[i];
+        std::vector<int> order = getClustersByDistance(positions[i]);
+        int cluster = order.front();
+        if (drone.cluster != -1 && drone.cluster != cluster &&
+                positions[i].distance(centroids[drone.cluster]) - positions[i].distance(centroids[cluster]) <= hysteresis)
+            cluster = drone.cluster;
+        drone.cluster = cluster;
+        sizes[cluster]++;
+        switches += tune(drone, 0, channels[cluster]);
+        // gateway: further radios bridge to the nearest other clusters
+        size_t radio = 1;
+        for (int other : order) {
+            if (radio >= drone.radios.size())
+                break;
+            if (other != cluster)
+                switches += tune(drone, radio++, channels[other]);
+        }
+    }
+    for (auto& gcs : groundStations) {
+        std::vector<int> order = getClustersByDistance(getGroundPosition(gcs));
+        bool listenToAll = (int)gcs.radios.size() >= k;
+        for (size_t radio = 0; radio < gcs.radios.size() && (int)radio < k; radio++)
+            switches += tune(gcs, radio, channels[listenToAll ? radio : order[radio]]);
+    }
+
+    for (int c = 0; c < k; c++)
+        emit(clusterSizeSignal, sizes[c]);
+    emit(channelSwitchesSignal, (long)switches);
+}
+
+int SwarmChannelPlanner::tune(Node& node, int radio, int channel)
+{
+    if (node.tunedChannels[radio] == channel)
+        return 0;
+    EV_DETAIL << "Tuning " << node.radios[radio]->getFullPath() << " to channel " << channel << endl;
+    node.radios[radio]->setChannelNumber(channel);
+    node.tunedChannels[radio] = channel;
+    return 1;
+}
+
+} // namespace droneswarm
@@ -0,0 +1,64 @@
+//===================================================================================
+// SWARM CHANNEL PLANNER - Spatial channel assignment for multi-radio swarms
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCHANNELPLANNER_H
+#define __DRONESWARM_SWARMCHANNELPLANNER_H
+
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/physicallayer/wireless/ieee80211/packetlevel/Ieee80211Radio.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmChannelPlanner : public cSimpleModule
+{
+  protected:
+    struct Node
+    {
+        IMobility *mobility = nullptr;
+        std::vector<physicallayer::Ieee80211Radio *> radios;   // wlan[0], wlan[1]...
+        std::vector<int> tunedChannels;                         // per radio, -1 before the first assignment
+        int cluster = -1;
+    };
+
+    // parameters
+    std::vector<int> channels;
+    double hysteresis = 0;
+    int maxIterations = 0;
+    simtime_t reassignInterval;
+
+    // context
+    std::vector<Node> drones;
+    std::vector<Node> groundStations;
+    cMessage *reassignTimer = nullptr;
+
+    // state
+    std::vector<Coord> centroids;       // per cluster (= per channel), ground plane
+
+    static simsignal_t clusterSizeSignal;
+    static simsignal_t channelSwitchesSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *msg) override;
+
+    Node collectNode(cModule *host) const;
+    void assign();
+    void seedCentroids(const std::vector<Coord>& positions);
+    std::vector<int> getClustersByDistance(const Coord& position) const;
+    int tune(Node& node, int radio, int channel);
+    static Coord getGroundPosition(const Node& node);
+
+  public:
+    virtual ~SwarmChannelPlanner();
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,163 @@
+//===================================================================================
+// SWARM CLUSTERING - Weighted cluster-head election for hierarchical telemetry
+//===================================================================================
+
+#include "clustering/SwarmClustering.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace droneswarm {
+
+Define_Module(SwarmClustering);
+
+simsignal_t SwarmClustering::clusterHeadSignal = cComponent::registerSignal("clusterHead");
+simsignal_t SwarmClustering::roleChangeSignal = cComponent::registerSignal("roleChange");
+simsignal_t SwarmClustering::clusterMembersSignal = cComponent::registerSignal("clusterMembers");
+
+void SwarmClustering::initialize()
+{
+    neighborValidity = par("neighborValidity");
+    idealDegree = par("idealDegree");
+    referenceSpeed = par("referenceSpeed");
+    degreeWeight = par("degreeWeight");
+    energyWeight = par("energyWeight");
+    mobilityWeight = par("mobilityWeight");
+    headHysteresis = par("headHysteresis");
+    if (idealDegree <= 0 || degreeWeight + energyWeight + mobilityWeight <= 0)
+        throw cRuntimeError("Invalid idealDegree or weight parameters");
+    energyStorage.reference(this, "energyStorageModule", false);
+    emit(clusterHeadSignal, false);
+}
+
+void SwarmClustering::handleMessage(cMessage *msg)
+{
+    throw cRuntimeError("SwarmClustering does not process messages");
+}
+
+void SwarmClustering::neighborHeard(uint32_t id, uint32_t neighborHead, uint16_t neighborWeight, const Coord& velocity)
+{
+    Neighbor& neighbor = neighbors[id];
+    neighbor.head = neighborHead;
+    neighbor.weight = neighborWeight;
+    neighbor.velocity = velocity;
+    neighbor.lastHeard = simTime();
+}
+
+uint16_t SwarmClustering::computeWeight(const Coord& ownVelocity) const
+{
+    int degree = neighbors.size();
+    double degreeScore = 1 - std::min(std::abs(degree - idealDegree) / (double)idealDegree, 1.0);
+
+    double energyScore = 1;
+    if (const power::IEpEnergyStorage *storage = energyStorage.get()) {
+        J nominal = storage->getNominalEnergyCapacity();
+        if (nominal > J(0))
+            energyScore = unit(storage->getResidualEnergyCapacity() / nominal).get();
+    }
+
+    double relativeSpeed = 0;
+    for (const auto& it : neighbors)
+        relativeSpeed += (it.second.velocity - ownVelocity).length();
+    if (degree > 0)
+        relativeSpeed /= degree;
+    double mobilityScore = 1 / (1 + relativeSpeed / referenceSpeed);
+
+    double score = (degreeWeight * degreeScore + energyWeight * energyScore + mobilityWeight * mobilityScore) /
+            (degreeWeight + energyWeight + mobilityWeight);
+    return (uint16_t)std::lround(std::min(std::max(score, 0.0), 1.0) * 0xFFFF);
+}
+
+bool SwarmClustering::outweighs(uint16_t weight1, uint32_t id1, uint16_t weight2, uint32_t id2)
+{
+    return weight1 > weight2 || (weight1 == weight2 && id1 < id2);
+}
+
+void SwarmClustering::setHead(uint32_t newHead)
+{
+    if (newHead == head)
+        return;
+    bool wasHead = isHead();
+    if (newHead == NO_CLUSTER)
+        EV_INFO << "Leaving cluster " << head << endl;
+    else
+        EV_INFO << "Joining cluster " << newHead << (newHead == self ? " as head" : "") << endl;
+    head = newHead;
+    emit(roleChangeSignal, 1L);
+    if (wasHead != isHead())
+        emit(clusterHeadSignal, isHead());
+}
+
+void SwarmClustering::update(const Coord& ownVelocity)
+{
+    simtime_t since = simTime() - neighborValidity;
+    for (auto it = neighbors.begin(); it != neighbors.end(); ) {
+        if (it->second.lastHeard < since)
+            it = neighbors.erase(it);
+        else
+            ++it;
+    }
+    weight = computeWeight(ownVelocity);
+    elect();
+
+    if (isHead()) {
+        long members = 0;
+        for (const auto& it : neighbors)
+            if (it.second.head == self)
+                members++;
+        emit(clusterMembersSignal, members);
+    }
+}
+
+void SwarmClustering::elect()
+{
+    if (isHead()) {
+        // two heads met: the weaker one resigns and joins the stronger
+        for (const auto& it : neighbors) {
+            const Neighbor& neighbor = it.second;
+            if (neighbor.head == it.first && neighbor.weight > weight + headHysteresis) {
+                setHead(it.first);
+                return;
+            }
+        }
+        return;
+    }
+    if (head != NO_CLUSTER) {
+        auto it = neighbors.find(head);
+        if (it != neighbors.end() && it->second.head == head)
+            return;     // least cluster change: keep a head that is still there
+    }
+
+    uint32_t bestHead = NO_CLUSTER;
+    uint16_t bestWeight = 0;
+    bool strongest = true;     // among the unaffiliated neighbors
+    for (const auto& it : neighbors) {
+        const Neighbor& neighbor = it.second;
+        if (neighbor.head == it.first) {
+            if (bestHead == NO_CLUSTER || outweighs(neighbor.weight, it.first, bestWeight, bestHead)) {
+                bestHead = it.first;
+                bestWeight = neighbor.weight;
+            }
+        }
+        else if (neighbor.head == NO_CLUSTER && outweighs(neighbor.weight, it.first, weight, self))
+            strongest = false;
+    }
+    if (bestHead != NO_CLUSTER)
+        setHead(bestHead);
+    else if (strongest)
+        setHead(self);
+    else
+        setHead(NO_CLUSTER);
+}
+
+bool SwarmClustering::isGateway() const
+{
+    if (head == NO_CLUSTER || isHead())
+        return false;
+    for (const auto& it : neighbors)
+        if (it.second.head != NO_CLUSTER && it.second.head != head)
+            return true;
+    return false;
+}
+
+} // namespace droneswarm
@@ -0,0 +1,83 @@
+//===================================================================================
+// SWARM CLUSTERING - Weighted cluster-head election for hierarchical telemetry
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCLUSTERING_H
+#define __DRONESWARM_SWARMCLUSTERING_H
+
+#include <unordered_map>
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/common/geometry/common/Coord.h"
+#include "inet/power/contract/IEpEnergyStorage.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmClustering : public cSimpleModule
+{
+  public:
+    static const uint32_t NO_CLUSTER = 0xFFFFFFFF;
+
+  protected:
+    struct Neighbor
+    {
+        uint32_t head = NO_CLUSTER;     // as advertised
+        uint16_t weight = 0;
+        Coord velocity;
+        simtime_t lastHeard;
+    };
+
+    // parameters
+    simtime_t neighborValidity;
+    int idealDegree = 0;
+    double referenceSpeed = 0;
+    double degreeWeight = 0;
+    double energyWeight = 0;
+    double mobilityWeight = 0;
+    int headHysteresis = 0;
+
+    // context
+    ModuleRefByPar<power::IEpEnergyStorage> energyStorage;
+    uint32_t self = 0;
+
+    // state
+    std::unordered_map<uint32_t, Neighbor> neighbors;
+    uint32_t head = NO_CLUSTER;
+    uint16_t weight = 0;
+
+    static simsignal_t clusterHeadSignal;
+    static simsignal_t roleChangeSignal;
+    static simsignal_t clusterMembersSignal;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+
+    uint16_t computeWeight(const Coord& ownVelocity) const;
+    static bool outweighs(uint16_t weight1, uint32_t id1, uint16_t weight2, uint32_t id2);
+    void setHead(uint32_t newHead);
+    void elect();
+
+  public:
+    // identity of this drone, the nodeId of its telemetry
+    void setNodeId(uint32_t nodeId) { self = nodeId; }
+
+    // called for every telemetry frame received straight from a neighbor
+    void neighborHeard(uint32_t id, uint32_t neighborHead, uint16_t neighborWeight, const Coord& velocity);
+
+    // election step, called before each own telemetry frame
+    void update(const Coord& ownVelocity);
+
+    uint32_t getClusterHead() const { return head; }
+    uint16_t getWeight() const { return weight; }
+    bool isHead() const { return head == self; }
+    bool isGateway() const;
+    bool isAggregator() const { return head == NO_CLUSTER || isHead() || isGateway(); }
+};
+
+} // namespace droneswarm
+
+#endif
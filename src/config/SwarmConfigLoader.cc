@@ -0,0 +1,207 @@
+//===================================================================================
+// SWARM CONFIG LOADER - Address/multicast plan for the drone swarm
+//===================================================================================
+
+#include "config/SwarmConfigLoader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace droneswarm {
+
+std::map<std::string, SwarmAddressPlan> SwarmConfigLoader::plans;
+std::map<std::string, bool> SwarmConfigLoader::validated;
+
+static std::string formatAddress(uint32_t address)
+{
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (address >> 24) & 0xff, (address >> 16) & 0xff, (address >> 8) & 0xff, address & 0xff);
+    return buf;
+}
+
+uint32_t SwarmConfigLoader::parseAddress(const char *text, const char *what)
+{
+    unsigned int a, b, c, d;
+    char tail;
+    if (text == nullptr || sscanf(text, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+        throw cRuntimeError("swarm config: invalid %s '%s'", what, text ? text : "");
+    return (a << 24) | (b << 16) | (c << 8) | d;
+}
+
+SwarmInterfaceRule SwarmConfigLoader::parseInterfaceRule(const cXMLElement *element)
+{
+    SwarmInterfaceRule rule;
+    const char *hosts = element->getAttribute("hosts");
+    const char *address = element->getAttribute("address");
+    const char *netmask = element->getAttribute("netmask");
+    if (!hosts || !address || !netmask)
+        throw cRuntimeError("swarm config: <interface> needs hosts, address and netmask attributes at %s", element->getSourceLocation());
+    rule.hosts = hosts;
+    rule.addressTemplate = address;
+    rule.netmask = parseAddress(netmask, "netmask");
+
+    // the template is four dot-separated octets, each either a literal or 'x'
+    std::stringstream octets(address);
+    std::string octet;
+    int freeBits = 0;
+    for (int i = 0; i < 4; i++) {
+        if (!std::getline(octets, octet, '.'))
+            throw cRuntimeError("swarm config: invalid address template '%s' at %s", address, element->getSourceLocation());
+        int shift = 24 - 8 * i;
+        if (octet == "x") {
+            // only the host part of an 'x' octet can actually vary
+            uint32_t hostBits = ~(rule.netmask >> shift) & 0xff;
+            while (hostBits) {
+                freeBits += hostBits & 1;
+                hostBits >>= 1;
+            }
+        }
+        else {
+            unsigned long value = 0;
+            size_t length = 0;
+            try {
+                value = std::stoul(octet, &length);
+            }
+            catch (const std::invalid_argument&) {
+            }
+            catch (const std::out_of_range&) {
+            }
+            if (length == 0 || length != octet.length() || value > 255)
+                throw cRuntimeError("swarm config: invalid octet '%s' in address template '%s' of <interface> at %s",
+                        octet.c_str(), address, element->getSourceLocation());
+            rule.fixedAddress |= value << shift;
+            rule.fixedMask |= 0xffu << shift;
+        }
+    }
+    // all-zeros and all-ones host parts are reserved
+    rule.capacity = freeBits >= 2 ? (uint64_t(1) << freeBits) - 2 : 0;
+    return rule;
+}
+
+SwarmMulticastRule SwarmConfigLoader::parseMulticastRule(const cXMLElement *element)
+{
+    SwarmMulticastRule rule;
+    const char *hosts = element->getAttribute("hosts");
+    const char *address = element->getAttribute("address");
+    const char *interfaces = element->getAttribute("interfaces");
+    if (!hosts || !address)
+        throw cRuntimeError("swarm config: <multicast-group> needs hosts and address attributes at %s", element->getSourceLocation());
+    rule.hosts = hosts;
+    rule.interfaces = interfaces ? interfaces : "*";
+    rule.address = parseAddress(address, "multicast address");
+    if ((rule.address >> 28) != 0xe)
+        throw cRuntimeError("swarm config: %s is not a multicast address at %s", address, element->getSourceLocation());
+    return rule;
+}
+
+const SwarmAddressPlan& SwarmConfigLoader::load(cXMLElement *config)
+{
+    if (config == nullptr)
+        throw cRuntimeError("swarm config: no XML document given");
+    std::string key = config->getSourceLocation();
+    auto it = plans.find(key);
+    if (it != plans.end())
+        return it->second;
+
+    SwarmAddressPlan plan;
+    plan.source = key;
+    for (cXMLElement *child : config->getChildrenByTagName("interface"))
+        plan.interfaces.push_back(parseInterfaceRule(child));
+    for (cXMLElement *child : config->getChildrenByTagName("multicast-group"))
+        plan.multicastGroups.push_back(parseMulticastRule(child));
+    if (plan.interfaces.empty())
+        throw cRuntimeError("swarm config: no <interface> rules in %s", key.c_str());
+    return plans[key] = plan;
+}
+
+std::vector<std::string> SwarmConfigLoader::listNodes(cModule *network, int numDrones, int numGCS)
+{
+    // the node vectors of the network, resized to numDrones/numGCS
+    std::vector<std::string> names;
+    std::set<std::string> vectors;
+    for (cModule::SubmoduleIterator it(network); !it.end(); ++it) {
+        cModule *node = *it;
+        if (!node->hasPar("numWlanInterfaces"))
+            continue;
+        if (!node->isVector()) {
+            names.push_back(node->getFullName());
+            continue;
+        }
+        if (!vectors.insert(node->getName()).second)
+            continue;
+        int size = !strcmp(node->getName(), "drone") ? numDrones : !strcmp(node->getName(), "gcs") ? numGCS : node->getVectorSize();
+        for (int i = 0; i < size; i++)
+            names.push_back(std::string(node->getName()) + "[" + std::to_string(i) + "]");
+    }
+    return names;
+}
+
+int SwarmConfigLoader::countMatchingNodes(const std::string& hosts, cModule *network, const std::vector<std::string>& nodes)
+{
+    // same matching semantics as Ipv4NetworkConfigurator: space-separated patterns
+    // tried against both the full name and the full path of each node
+    std::vector<cPatternMatcher *> matchers;
+    std::stringstream patterns(hosts);
+    std::string pattern;
+    while (patterns >> pattern)
+        matchers.push_back(new cPatternMatcher(pattern.c_str(), true, true, true));
+
+    int count = 0;
+    std::string prefix = network->getFullPath() + ".";
+    for (const auto& name : nodes) {
+        for (auto matcher : matchers) {
+            if (matcher->matches(name.c_str()) || matcher->matches((prefix + name).c_str())) {
+                count++;
+                break;
+            }
+        }
+    }
+    for (auto matcher : matchers)
+        delete matcher;
+    return count;
+}
+
+void SwarmConfigLoader::validate(const SwarmAddressPlan& plan, cModule *network, int numDrones, int numGCS)
+{
+    std::string key = plan.source + "#" + std::to_string(numDrones) + "#" + std::to_string(numGCS);
+    if (validated.count(key))
+        return;
+
+    std::vector<std::string> nodes = listNodes(network, numDrones, numGCS);
+    int covered = 0;
+    for (auto& rule : plan.interfaces) {
+        int matched = countMatchingNodes(rule.hosts, network, nodes);
+        if (matched == 0)
+            throw cRuntimeError("swarm config: interface rule hosts=\"%s\" matches no node (%s, numDrones=%d, numGCS=%d)",
+                    rule.hosts.c_str(), plan.source.c_str(), numDrones, numGCS);
+        if ((uint64_t)matched > rule.capacity)
+            throw cRuntimeError("swarm config: %s/%s has room for %llu hosts but \"%s\" matches %d nodes (numDrones=%d, numGCS=%d)",
+                    rule.addressTemplate.c_str(), formatAddress(rule.netmask).c_str(), (unsigned long long)rule.capacity,
+                    rule.hosts.c_str(), matched, numDrones, numGCS);
+        covered += matched;
+    }
+    if (covered != numDrones + numGCS)
+        throw cRuntimeError("swarm config: interface rules cover %d nodes, but the network has %d drones and %d GCS (%s)",
+                covered, numDrones, numGCS, plan.source.c_str());
+
+    // drones and GCS share one wireless link, so the configurator needs a common subnet
+    const SwarmInterfaceRule& first = plan.interfaces.front();
+    for (auto& rule : plan.interfaces) {
+        uint32_t common = first.fixedMask & rule.fixedMask & first.netmask;
+        if (rule.netmask != first.netmask || (rule.fixedAddress & common) != (first.fixedAddress & common))
+            throw cRuntimeError("swarm config: %s/%s and %s/%s are not in the same subnet, but all nodes share one wireless link",
+                    first.addressTemplate.c_str(), formatAddress(first.netmask).c_str(),
+                    rule.addressTemplate.c_str(), formatAddress(rule.netmask).c_str());
+    }
+
+    for (auto& group : plan.multicastGroups)
+        if (countMatchingNodes(group.hosts, network, nodes) == 0)
+            throw cRuntimeError("swarm config: multicast group %s hosts=\"%s\" matches no node", formatAddress(group.address).c_str(), group.hosts.c_str());
+
+    validated[key] = true;
+}
+
+} // namespace droneswarm
@@ -0,0 +1,79 @@
+//===================================================================================
+// SWARM CONFIG LOADER - Address/multicast plan for the drone swarm
+//===================================================================================
+// Parses the <interface> and <multicast-group> rules of swarm_config.xml (the same
+// document handed to Ipv4NetworkConfigurator) into a compact plan, validates it
+// against the network size and caches the result for the lifetime of the process,
+// so repetitions of the same config do not parse or re-check it again.
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCONFIGLOADER_H
+#define __DRONESWARM_SWARMCONFIGLOADER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <omnetpp.h>
+
+namespace droneswarm {
+
+using namespace omnetpp;
+
+struct SwarmInterfaceRule
+{
+    std::string hosts;          // e.g. "drone[*]"
+    std::string addressTemplate; // e.g. "10.1.x.x"
+    uint32_t fixedAddress = 0;  // template with 'x' octets zeroed
+    uint32_t fixedMask = 0;     // 0xff for every literal octet of the template
+    uint32_t netmask = 0;
+    uint64_t capacity = 0;      // assignable host addresses
+};
+
+struct SwarmMulticastRule
+{
+    std::string hosts;
+    std::string interfaces;
+    uint32_t address = 0;
+};
+
+struct SwarmAddressPlan
+{
+    std::string source;         // file:line of the <config> element
+    std::vector<SwarmInterfaceRule> interfaces;
+    std::vector<SwarmMulticastRule> multicastGroups;
+};
+
+class SwarmConfigLoader
+{
+  public:
+    /** Returns the cached plan for the given document, parsing it on first use. */
+    static const SwarmAddressPlan& load(cXMLElement *config);
+
+    /**
+     * Checks the plan against the node population of the network with
+     * numDrones drones and numGCS GCS:
+     * every drone/GCS must be covered by an interface rule, every rule must have
+     * room for the nodes it matches, all rules must share one subnet (there is a
+     * single wireless link), and multicast groups must be valid class D addresses.
+     * Throws cRuntimeError on the first mismatch. Results are cached per
+     * (document, numDrones, numGCS), so only the first run of a batch pays for it.
+     */
+    static void validate(const SwarmAddressPlan& plan, cModule *network, int numDrones, int numGCS);
+
+    static uint32_t parseAddress(const char *text, const char *what);
+
+  private:
+    static std::map<std::string, SwarmAddressPlan> plans;
+    static std::map<std::string, bool> validated;
+
+    static SwarmInterfaceRule parseInterfaceRule(const cXMLElement *element);
+    static SwarmMulticastRule parseMulticastRule(const cXMLElement *element);
+    static std::vector<std::string> listNodes(cModule *network, int numDrones, int numGCS);
+    static int countMatchingNodes(const std::string& hosts, cModule *network, const std::vector<std::string>& nodes);
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,75 @@
+//===================================================================================
+// SWARM CONFIG VALIDATOR
+//===================================================================================
+
+#include "config/SwarmConfigValidator.h"
+
+#include <cstdlib>
+#include <sstream>
+
+#include "config/SwarmConfigLoader.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmConfigValidator);
+
+std::set<std::pair<int, int>> SwarmConfigValidator::collectNetworkSizes() const
+{
+    cModule *network = getParentModule();
+    int numDrones = network->par("numDrones");
+    int numGCS = network->par("numGCS");
+    std::set<std::pair<int, int>> sizes = {{numDrones, numGCS}};
+
+    // the detailed unrolling lists, per run, the entries that contain
+    // iteration variables with their values substituted ("\t*.numDrones = 100")
+    cConfigurationEx *config = getEnvir()->getConfigEx();
+    std::string dronesPath = network->getFullPath() + ".numDrones";
+    std::string gcsPath = network->getFullPath() + ".numGCS";
+    for (const std::string& run : config->unrollConfig(config->getActiveConfigName(), true)) {
+        std::pair<int, int> size = {numDrones, numGCS};
+        std::istringstream lines(run);
+        std::string line;
+        while (std::getline(lines, line)) {
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            size_t equals = line.find(" = ");
+            if (equals == std::string::npos)
+                continue;
+            size_t begin = line.find_first_not_of(" \t");
+            std::string key = line.substr(begin, equals - begin);
+            const char *value = line.c_str() + equals + 3;
+            char *end = nullptr;
+            long number = strtol(value, &end, 10);
+            if (end == value || *end != '\0')
+                continue;
+            cPatternMatcher matcher(key.c_str(), true, true, true);
+            if (matcher.matches(dronesPath.c_str()))
+                size.first = number;
+            else if (matcher.matches(gcsPath.c_str()))
+                size.second = number;
+        }
+        sizes.insert(size);
+    }
+    return sizes;
+}
+
+void SwarmConfigValidator::initialize()
+{
+    // single-stage initialize() runs before every multi-stage INET module has
+    // left stage 0, so a bad plan stops the run before addresses are assigned;
+    // every network size of the config's sweep is checked, so the first run
+    // of a batch already fails for a size that only a later run would use
+    const SwarmAddressPlan& plan = SwarmConfigLoader::load(par("config"));
+    auto sizes = collectNetworkSizes();
+    for (const auto& size : sizes)
+        SwarmConfigLoader::validate(plan, getParentModule(), size.first, size.second);
+    EV_INFO << "Swarm config " << plan.source << ": " << plan.interfaces.size() << " interface rules, "
+            << plan.multicastGroups.size() << " multicast groups, valid for "
+            << sizes.rbegin()->first << " drones and the " << sizes.size() << " network sizes of the sweep" << endl;
+}
+
+void SwarmConfigValidator::handleMessage(cMessage *msg)
+{
+    throw cRuntimeError("This module does not process messages");
+}
+
+} // namespace droneswarm
@@ -0,0 +1,29 @@
+//===================================================================================
+// SWARM CONFIG VALIDATOR
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCONFIGVALIDATOR_H
+#define __DRONESWARM_SWARMCONFIGVALIDATOR_H
+
+#include <set>
+#include <utility>
+
+#include <omnetpp.h>
+
+namespace droneswarm {
+
+using namespace omnetpp;
+
+class SwarmConfigValidator : public cSimpleModule
+{
+  protected:
+    // (numDrones, numGCS) of every run of the active config
+    std::set<std::pair<int, int>> collectNetworkSizes() const;
+
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,61 @@
+//===================================================================================
+// SEQUENCE WINDOW - Per-source duplicate suppression
+//===================================================================================
+// Ring buffer of "seen" bits over the last SIZE sequence numbers of a source.
+// O(1) per lookup and a fixed 16 + SIZE/8 bytes per source, instead of a
+// time-expired (source, sequence) set that grows with swarm size × rate.
+//===================================================================================
+
+#ifndef __DRONESWARM_SEQUENCEWINDOW_H
+#define __DRONESWARM_SEQUENCEWINDOW_H
+
+#include <bitset>
+#include <cstdint>
+
+namespace droneswarm {
+
+class SequenceWindow
+{
+  public:
+    static const int SIZE = 128;    // > telemetry rate × max relay path delay
+
+  protected:
+    bool initialized = false;
+    uint16_t highest = 0;
+    std::bitset<SIZE> seen;         // bit (seq % SIZE) set if seq was accepted
+
+  public:
+    /**
+     * Records the sequence number and returns true if it had not been seen
+     * before. Numbers older than the window are reported as duplicates.
+     */
+    bool accept(uint16_t sequence)
+    {
+        if (!initialized) {
+            initialized = true;
+            highest = sequence;
+            seen.set(sequence % SIZE);
+            return true;
+        }
+        int16_t delta = (int16_t)(uint16_t)(sequence - highest);
+        if (delta > 0) {
+            // slide the window, forgetting the slots we move over
+            if (delta >= SIZE)
+                seen.reset();
+            else
+                for (int i = 1; i <= delta; i++)
+                    seen.reset((uint16_t)(highest + i) % SIZE);
+            highest = sequence;
+            seen.set(sequence % SIZE);
+            return true;
+        }
+        if (-delta >= SIZE || seen.test(sequence % SIZE))
+            return false;
+        seen.set(sequence % SIZE);
+        return true;
+    }
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,225 @@
+//===================================================================================
+// SWARM DISSEMINATION - Multi-hop telemetry relay with broadcast-storm control
+//===================================================================================
+
+#include "dissemination/SwarmDissemination.h"
+
+#include "inet/networklayer/common/HopLimitTag_m.h"
+#include "inet/networklayer/common/IpProtocolId_m.h"
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+#include "inet/transportlayer/udp/UdpHeader_m.h"
+
+#include "routing/SwarmIpv4Options.h"
+#include "routing/SwarmOlsr.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmDissemination);
+
+simsignal_t SwarmDissemination::relayedSignal = cComponent::registerSignal("relayed");
+simsignal_t SwarmDissemination::suppressedSignal = cComponent::registerSignal("suppressed");
+simsignal_t SwarmDissemination::duplicateSignal = cComponent::registerSignal("duplicate");
+simsignal_t SwarmDissemination::channelTimeSavedSignal = cComponent::registerSignal("channelTimeSaved");
+
+SwarmDissemination::~SwarmDissemination()
+{
+    cancelPending();
+}
+
+void SwarmDissemination::initialize(int stage)
+{
+    ApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        std::string strategyName = par("strategy").stdstringValue();
+        if (strategyName == "none")
+            strategy = STRATEGY_NONE;
+        else if (strategyName == "flood")
+            strategy = STRATEGY_FLOOD;
+        else if (strategyName == "probabilistic")
+            strategy = STRATEGY_PROBABILISTIC;
+        else if (strategyName == "counter")
+            strategy = STRATEGY_COUNTER;
+        else
+            strategy = STRATEGY_MPR;
+        telemetryPort = par("telemetryPort");
+        rebroadcastProbability = par("rebroadcastProbability");
+        counterThreshold = par("counterThreshold");
+        bitrate = par("bitrate");
+        perFrameOverhead = par("perFrameOverhead");
+        macOverhead = B(par("macOverhead").intValue());
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        networkProtocol.reference(this, "networkProtocolModule", true);
+    }
+    else if (stage == INITSTAGE_ROUTING_PROTOCOLS) {
+        networkProtocol->registerHook(0, this);
+    }
+}
+
+void SwarmDissemination::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg->isSelfMessage())
+        processRebroadcastTimer(msg);
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+bool SwarmDissemination::isTelemetryDatagram(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header) const
+{
+    if (!ipv4Header->getDestAddress().isMulticast() || ipv4Header->getProtocolId() != IP_PROT_UDP || ipv4Header->getFragmentOffset() != 0)
+        return false;
+    const auto& udpHeader = datagram->peekAt<UdpHeader>(ipv4Header->getChunkLength());
+    return udpHeader->getDestinationPort() == telemetryPort;
+}
+
+void SwarmDissemination::stampRelayOption(Packet *datagram, NodeId originator, uint16_t sequence)
+{
+    auto option = new SwarmRelayOption();
+    option->setOriginator(Ipv4Address(originator));
+    option->setSequence(sequence);
+    insertIpv4Option(datagram, option);
+}
+
+bool SwarmDissemination::shouldRelay(const Ptr<const Ipv4Header>& ipv4Header)
+{
+    switch (strategy) {
+        case STRATEGY_NONE:
+            return false;
+        case STRATEGY_FLOOD:
+        case STRATEGY_COUNTER:     // decided when the assessment delay expires
+            return true;
+        case STRATEGY_PROBABILISTIC:
+            return uniform(0, 1) < rebroadcastProbability;
+        case STRATEGY_MPR:
+            return olsr->isMprSelector(ipv4Header->getSrcAddress());
+    }
+    return false;
+}
+
+void SwarmDissemination::scheduleRebroadcast(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header, const MessageId& id)
+{
+    B udpOffset = ipv4Header->getChunkLength();
+    const auto& udpHeader = datagram->peekAt<UdpHeader>(udpOffset);
+    B payloadOffset = udpOffset + udpHeader->getChunkLength();
+    auto packet = new Packet(datagram->getName(), datagram->peekAt(payloadOffset, datagram->getDataLength() - payloadOffset));
+    packet->addTag<HopLimitReq>()->setHopLimit(ipv4Header->getTimeToLive() - 1);
+
+    auto& entry = pending[id];
+    entry.id = id;
+    entry.packet = packet;
+    entry.timer = new cMessage("RebroadcastTimer");
+    entry.timer->setContextPointer(&entry);
+    scheduleAfter(par("rebroadcastDelay"), entry.timer);
+}
+
+void SwarmDissemination::processRebroadcastTimer(cMessage *timer)
+{
+    auto entry = static_cast<PendingRebroadcast *>(timer->getContextPointer());
+    Packet *packet = entry->packet;
+    if (strategy == STRATEGY_COUNTER && entry->copies >= counterThreshold) {
+        // enough neighbors already covered the area around us
+        suppress(packet->getDataLength() + B(28));  // + Ipv4/UDP headers
+        delete packet;
+    }
+    else {
+        auto relayReq = packet->addTag<SwarmRelayReq>();
+        relayReq->setOriginator(Ipv4Address(entry->id.first));
+        relayReq->setSequence(entry->id.second);
+        socket.sendTo(packet, Ipv4Address::ALL_HOSTS_MCAST, telemetryPort);
+        emit(relayedSignal, 1L);
+    }
+    pending.erase(entry->id);
+    delete timer;
+}
+
+void SwarmDissemination::suppress(B datagramLength)
+{
+    emit(suppressedSignal, 1L);
+    double bits = b(datagramLength + macOverhead).get();
+    emit(channelTimeSavedSignal, perFrameOverhead + SimTime(bits / bitrate));
+}
+
+void SwarmDissemination::cancelPending()
+{
+    for (auto& it : pending) {
+        cancelAndDelete(it.second.timer);
+        delete it.second.packet;
+    }
+    pending.clear();
+}
+
+INetfilter::IHook::Result SwarmDissemination::datagramPreRoutingHook(Packet *datagram)
+{
+    if (!isUp())
+        return ACCEPT;
+    const auto& ipv4Header = datagram->peekAtFront<Ipv4Header>();
+    if (!isTelemetryDatagram(datagram, ipv4Header))
+        return ACCEPT;
+    auto option = dynamic_cast<const SwarmRelayOption *>(ipv4Header->findOptionByType(IPOPTION_TLV_SWARM_RELAY));
+    if (option == nullptr)
+        return ACCEPT;
+
+    NodeId originator = option->getOriginator().toIpv4().getInt();
+    MessageId id(originator, option->getSequence());
+    if (originator == self || !windows[originator].accept(id.second)) {
+        auto it = pending.find(id);
+        if (it != pending.end())
+            it->second.copies++;
+        emit(duplicateSignal, 1L);
+        return DROP;
+    }
+
+    if (ipv4Header->getTimeToLive() > 1 && strategy != STRATEGY_NONE) {
+        if (shouldRelay(ipv4Header))
+            scheduleRebroadcast(datagram, ipv4Header, id);
+        else
+            suppress(ipv4Header->getTotalLengthField());
+    }
+    return ACCEPT;
+}
+
+INetfilter::IHook::Result SwarmDissemination::datagramLocalOutHook(Packet *datagram)
+{
+    if (!isUp())
+        return ACCEPT;
+    if (auto relayReq = datagram->findTag<SwarmRelayReq>())
+        stampRelayOption(datagram, relayReq->getOriginator().toIpv4().getInt(), relayReq->getSequence());
+    else if (isTelemetryDatagram(datagram, datagram->peekAtFront<Ipv4Header>()))
+        stampRelayOption(datagram, self, sequence++);
+    return ACCEPT;
+}
+
+void SwarmDissemination::handleStartOperation(LifecycleOperation *operation)
+{
+    outputInterface = interfaceTable->findInterfaceByName(par("interfaceName"));
+    if (outputInterface == nullptr)
+        throw cRuntimeError("Interface '%s' not found", par("interfaceName").stringValue());
+    self = outputInterface->getProtocolData<Ipv4InterfaceData>()->getIPAddress().getInt();
+    if (strategy == STRATEGY_MPR) {
+        olsr = dynamic_cast<SwarmOlsr *>(getModuleByPath(par("routingModule")));
+        if (olsr == nullptr)
+            throw cRuntimeError("Strategy \"mpr\" needs SwarmOlsr at '%s'", par("routingModule").stringValue());
+    }
+
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), par("localPort"));
+    socket.setMulticastOutputInterface(outputInterface->getInterfaceId());
+    socket.setMulticastLoop(false);
+}
+
+void SwarmDissemination::handleStopOperation(LifecycleOperation *operation)
+{
+    cancelPending();
+    socket.close();
+}
+
+void SwarmDissemination::handleCrashOperation(LifecycleOperation *operation)
+{
+    cancelPending();
+    socket.destroy();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,107 @@
+//===================================================================================
+// SWARM DISSEMINATION - Multi-hop telemetry relay with broadcast-storm control
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMDISSEMINATION_H
+#define __DRONESWARM_SWARMDISSEMINATION_H
+
+#include <map>
+#include <unordered_map>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/networklayer/contract/INetfilter.h"
+#include "inet/networklayer/ipv4/Ipv4Header_m.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "dissemination/SequenceWindow.h"
+#include "dissemination/SwarmDissemination_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmOlsr;
+
+class SwarmDissemination : public ApplicationBase, public NetfilterBase::HookBase, public UdpSocket::ICallback
+{
+  public:
+    enum Strategy { STRATEGY_NONE, STRATEGY_FLOOD, STRATEGY_PROBABILISTIC, STRATEGY_COUNTER, STRATEGY_MPR };
+
+  protected:
+    typedef uint32_t NodeId;
+    typedef std::pair<NodeId, uint16_t> MessageId;
+
+    struct PendingRebroadcast
+    {
+        MessageId id;
+        Packet *packet = nullptr;   // payload to re-send
+        int copies = 1;             // copies heard so far, including the first
+        cMessage *timer = nullptr;
+    };
+
+    // parameters
+    Strategy strategy = STRATEGY_COUNTER;
+    int telemetryPort = -1;
+    double rebroadcastProbability = 0;
+    int counterThreshold = 0;
+    double bitrate = 0;
+    simtime_t perFrameOverhead;
+    B macOverhead;
+
+    // context
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    ModuleRefByPar<INetfilter> networkProtocol;
+    SwarmOlsr *olsr = nullptr;
+    NetworkInterface *outputInterface = nullptr;
+    NodeId self = 0;
+    UdpSocket socket;
+
+    // state
+    uint16_t sequence = 0;
+    std::unordered_map<NodeId, SequenceWindow> windows;
+    std::map<MessageId, PendingRebroadcast> pending;
+
+    static simsignal_t relayedSignal;
+    static simsignal_t suppressedSignal;
+    static simsignal_t duplicateSignal;
+    static simsignal_t channelTimeSavedSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+
+    bool isTelemetryDatagram(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header) const;
+    void stampRelayOption(Packet *datagram, NodeId originator, uint16_t sequence);
+    bool shouldRelay(const Ptr<const Ipv4Header>& ipv4Header);
+    void scheduleRebroadcast(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header, const MessageId& id);
+    void processRebroadcastTimer(cMessage *timer);
+    void suppress(B datagramLength);
+    void cancelPending();
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override { delete packet; }
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override { delete indication; }
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmDissemination();
+
+    // netfilter
+    virtual Result datagramPreRoutingHook(Packet *datagram) override;
+    virtual Result datagramForwardHook(Packet *datagram) override { return ACCEPT; }
+    virtual Result datagramPostRoutingHook(Packet *datagram) override { return ACCEPT; }
+    virtual Result datagramLocalInHook(Packet *datagram) override { return ACCEPT; }
+    virtual Result datagramLocalOutHook(Packet *datagram) override;
+};
+
+} // namespace droneswarm
+
+#endif
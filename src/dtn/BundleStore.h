@@ -0,0 +1,169 @@
+//===================================================================================
+// BUNDLE STORE - Bounded DTN bundle storage with priority eviction
+//===================================================================================
+// One ring buffer per priority class over a shared bundle budget. Bundles are
+// appended at the tail of their class and forwarded oldest first, highest
+// class first. When the store is full, the oldest bundle of the lowest class
+// below the incoming one is evicted; an incoming bundle of the lowest class
+// is refused instead. Removal after custody transfer leaves a tombstone that
+// is reclaimed when it reaches the head, so every operation except lookup by
+// id is O(1) and the memory per node is fixed.
+//===================================================================================
+
+#ifndef __DRONESWARM_BUNDLESTORE_H
+#define __DRONESWARM_BUNDLESTORE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "inet/common/Units.h"
+
+namespace droneswarm {
+
+class BundleStore
+{
+  public:
+    static const int NUM_PRIORITIES = 3;    // bulk, normal, expedited
+
+    struct Bundle
+    {
+        bool valid = false;
+        uint32_t source = 0;
+        uint32_t sequence = 0;
+        int priority = 0;
+        omnetpp::simtime_t creationTime;
+        inet::B length;
+        omnetpp::simtime_t lastSent;        // last transmission to a custodian
+    };
+
+  protected:
+    struct Ring
+    {
+        std::vector<Bundle> slots;
+        int head = 0;
+        int size = 0;                       // occupied slots, tombstones included
+    };
+
+    int capacity = 0;
+    int count = 0;
+    inet::B occupancy = inet::B(0);
+    Ring rings[NUM_PRIORITIES];
+
+    Bundle& at(Ring& ring, int i) { return ring.slots[(ring.head + i) % capacity]; }
+
+    void trim(Ring& ring)
+    {
+        while (ring.size > 0 && !ring.slots[ring.head].valid) {
+            ring.head = (ring.head + 1) % capacity;
+            ring.size--;
+        }
+    }
+
+    /** Evicts the oldest bundle of the lowest class below priority. */
+    bool evictBelow(int priority, Bundle& evicted)
+    {
+        for (int p = 0; p < priority; p++) {
+            Ring& ring = rings[p];
+            trim(ring);
+            if (ring.size > 0) {
+                evicted = ring.slots[ring.head];
+                remove(ring.slots[ring.head]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void compact(Ring& ring)
+    {
+        std::vector<Bundle> live;
+        for (int i = 0; i < ring.size; i++)
+            if (at(ring, i).valid)
+                live.push_back(at(ring, i));
+        for (auto& slot : ring.slots)
+            slot.valid = false;
+        for (int i = 0; i < (int)live.size(); i++)
+            ring.slots[i] = live[i];
+        ring.head = 0;
+        ring.size = live.size();
+    }
+
+  public:
+    void setCapacity(int bundles)
+    {
+        capacity = bundles;
+        count = 0;
+        occupancy = inet::B(0);
+        for (auto& ring : rings) {
+            ring.slots.assign(capacity, Bundle());
+            ring.head = ring.size = 0;
+        }
+    }
+
+    int getCapacity() const { return capacity; }
+    int getNumBundles() const { return count; }
+    inet::B getOccupancy() const { return occupancy; }
+
+    /**
+     * Stores the bundle. Returns false if it was refused; if another bundle
+     * had to make room, it is copied to evicted and evictedValid is set.
+     */
+    bool insert(const Bundle& bundle, Bundle& evicted, bool& evictedValid)
+    {
+        evictedValid = false;
+        if (count >= capacity) {
+            if (!evictBelow(bundle.priority, evicted))
+                return false;
+            evictedValid = true;
+        }
+        Ring& ring = rings[bundle.priority];
+        trim(ring);
+        if (ring.size == capacity)
+            compact(ring);      // only tombstones behind the head can fill it
+        Bundle& slot = at(ring, ring.size++);
+        slot = bundle;
+        slot.valid = true;
+        count++;
+        occupancy += bundle.length;
+        return true;
+    }
+
+    void remove(Bundle& bundle)
+    {
+        if (!bundle.valid)
+            return;
+        bundle.valid = false;
+        count--;
+        occupancy -= bundle.length;
+        trim(rings[bundle.priority]);
+    }
+
+    Bundle *find(uint32_t source, uint32_t sequence)
+    {
+        for (auto& ring : rings)
+            for (int i = 0; i < ring.size; i++) {
+                Bundle& bundle = at(ring, i);
+                if (bundle.valid && bundle.source == source && bundle.sequence == sequence)
+                    return &bundle;
+            }
+        return nullptr;
+    }
+
+    /** Oldest bundle of the highest class not sent within retryInterval. */
+    Bundle *next(omnetpp::simtime_t now, omnetpp::simtime_t retryInterval)
+    {
+        for (int p = NUM_PRIORITIES - 1; p >= 0; p--) {
+            Ring& ring = rings[p];
+            for (int i = 0; i < ring.size; i++) {
+                Bundle& bundle = at(ring, i);
+                if (bundle.valid && (bundle.lastSent == omnetpp::SIMTIME_ZERO || now - bundle.lastSent >= retryInterval))
+                    return &bundle;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,318 @@
+//===================================================================================
+// SWARM DTN APP - Store-carry-forward bundle layer for partitioned swarms
+//===================================================================================
+
+#include "dtn/SwarmDtnApp.h"
+
+#include "inet/common/Simsignals.h"
+#include "inet/networklayer/common/HopLimitTag_m.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmDtnApp);
+
+simsignal_t SwarmDtnApp::bundleCreatedSignal = cComponent::registerSignal("bundleCreated");
+simsignal_t SwarmDtnApp::bundleRefusedSignal = cComponent::registerSignal("bundleRefused");
+simsignal_t SwarmDtnApp::bundleEvictedSignal = cComponent::registerSignal("bundleEvicted");
+simsignal_t SwarmDtnApp::bundleForwardedSignal = cComponent::registerSignal("bundleForwarded");
+simsignal_t SwarmDtnApp::custodyAcceptedSignal = cComponent::registerSignal("custodyAccepted");
+simsignal_t SwarmDtnApp::bufferOccupancySignal = cComponent::registerSignal("bufferOccupancy");
+simsignal_t SwarmDtnApp::bundleDeliveredSignal = cComponent::registerSignal("bundleDelivered");
+simsignal_t SwarmDtnApp::duplicateDeliverySignal = cComponent::registerSignal("duplicateDelivery");
+
+SwarmDtnApp::~SwarmDtnApp()
+{
+    cancelAndDelete(bundleTimer);
+    cancelAndDelete(beaconTimer);
+    cancelAndDelete(forwardTimer);
+}
+
+void SwarmDtnApp::initialize(int stage)
+{
+    ApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        sink = par("sink");
+        port = par("port");
+        startTime = par("startTime");
+        stopTime = par("stopTime");
+        if (stopTime >= SIMTIME_ZERO && stopTime < startTime)
+            throw cRuntimeError("Invalid startTime/stopTime parameters");
+        payloadLength = B(par("payloadLength").intValue());
+        neighborTimeout = par("neighborTimeout");
+        transitivePenalty = par("transitivePenalty");
+        forwardInterval = par("forwardInterval");
+        retryInterval = par("retryInterval");
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        store.setCapacity(par("storeCapacity"));
+        bundleTimer = new cMessage("BundleTimer");
+        beaconTimer = new cMessage("BeaconTimer");
+        forwardTimer = new cMessage("ForwardTimer");
+    }
+}
+
+void SwarmDtnApp::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg == bundleTimer) {
+        createBundle();
+        simtime_t next = simTime() + par("bundleInterval");
+        if (stopTime < SIMTIME_ZERO || next < stopTime)
+            scheduleAt(next, bundleTimer);
+    }
+    else if (msg == beaconTimer) {
+        sendBeacon();
+        scheduleAfter(par("beaconInterval"), beaconTimer);
+    }
+    else if (msg == forwardTimer)
+        forwardBundle();
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmDtnApp::createBundle()
+{
+    BundleStore::Bundle bundle;
+    bundle.source = self.toIpv4().getInt();
+    bundle.sequence = sequence++;
+    bundle.priority = par("bundlePriority").intValue();
+    if (bundle.priority < 0 || bundle.priority >= BundleStore::NUM_PRIORITIES)
+        throw cRuntimeError("bundlePriority must be in 0..%d", BundleStore::NUM_PRIORITIES - 1);
+    bundle.creationTime = simTime();
+    bundle.length = payloadLength;
+    emit(bundleCreatedSignal, 1L);
+    if (storeBundle(bundle))
+        scheduleForward(SIMTIME_ZERO);
+}
+
+bool SwarmDtnApp::storeBundle(const BundleStore::Bundle& bundle)
+{
+    BundleStore::Bundle evicted;
+    bool evictedValid;
+    if (!store.insert(bundle, evicted, evictedValid)) {
+        emit(bundleRefusedSignal, 1L);
+        return false;
+    }
+    if (evictedValid)
+        emit(bundleEvictedSignal, 1L);
+    emit(bufferOccupancySignal, (long)store.getNumBundles());
+    return true;
+}
+
+void SwarmDtnApp::sendChunk(const Ptr<const Chunk>& chunk, const char *name)
+{
+    auto packet = new Packet(name, chunk);
+    packet->addTag<HopLimitReq>()->setHopLimit(1);
+    emit(packetSentSignal, packet);
+    socket.sendTo(packet, destAddress, port);
+}
+
+void SwarmDtnApp::sendBeacon()
+{
+    const auto& beacon = makeShared<SwarmDtnBeacon>();
+    beacon->setAddress(self);
+    beacon->setGcsEncounterTime(sink ? simTime() : gcsEncounterTime);
+    beacon->setGcs(sink);
+    beacon->setStoredBundles(store.getNumBundles());
+    sendChunk(beacon, "SwarmDtnBeacon");
+}
+
+const SwarmDtnApp::Neighbor *SwarmDtnApp::findCustodian()
+{
+    simtime_t now = simTime();
+    const Neighbor *best = nullptr;
+    for (auto it = neighbors.begin(); it != neighbors.end();) {
+        const Neighbor& neighbor = it->second;
+        if (now - neighbor.lastHeard > neighborTimeout) {
+            it = neighbors.erase(it);
+            continue;
+        }
+        if (neighbor.gcs)
+            return &neighbor;
+        if (best == nullptr || neighbor.gcsEncounterTime > best->gcsEncounterTime)
+            best = &neighbor;
+        ++it;
+    }
+    // only hand over along the encounter-age gradient
+    return best != nullptr && best->gcsEncounterTime > gcsEncounterTime ? best : nullptr;
+}
+
+void SwarmDtnApp::scheduleForward(simtime_t delay)
+{
+    if (!sink && !forwardTimer->isScheduled())
+        scheduleAfter(delay, forwardTimer);
+}
+
+void SwarmDtnApp::forwardBundle()
+{
+    if (store.getNumBundles() == 0)
+        return;
+    const Neighbor *custodian = findCustodian();
+    if (custodian == nullptr)
+        return;     // carry until a beacon reveals a better custodian
+    BundleStore::Bundle *bundle = store.next(simTime(), retryInterval);
+    if (bundle == nullptr) {
+        scheduleForward(retryInterval);     // all stored bundles await custody ACKs
+        return;
+    }
+
+    const auto& chunk = makeShared<SwarmDtnBundle>();
+    chunk->setCustodian(custodian->address);
+    chunk->setSource(bundle->source);
+    chunk->setSequence(bundle->sequence);
+    chunk->setPriority(bundle->priority);
+    chunk->setCreationTime(bundle->creationTime);
+    chunk->setChunkLength(B(24) + bundle->length);
+    bundle->lastSent = simTime();
+    emit(bundleForwardedSignal, 1L);
+    sendChunk(chunk, "SwarmDtnBundle");
+    scheduleForward(forwardInterval);
+}
+
+void SwarmDtnApp::processBeacon(const Ptr<const SwarmDtnBeacon>& beacon)
+{
+    simtime_t now = simTime();
+    L3Address address = beacon->getAddress();
+    Neighbor& neighbor = neighbors[address.toIpv4().getInt()];
+    neighbor.address = address;
+    neighbor.gcsEncounterTime = beacon->getGcsEncounterTime();
+    neighbor.lastHeard = now;
+    neighbor.gcs = beacon->getGcs();
+
+    if (!sink) {
+        // a direct GCS contact is fresh now; a transitive one ages per hop
+        simtime_t encounter = neighbor.gcs ? now : neighbor.gcsEncounterTime - transitivePenalty;
+        if (encounter > gcsEncounterTime)
+            gcsEncounterTime = encounter;
+        scheduleForward(SIMTIME_ZERO);
+    }
+}
+
+void SwarmDtnApp::processBundle(const Ptr<const SwarmDtnBundle>& chunk, const L3Address& sender)
+{
+    if (chunk->getCustodian() != self)
+        return;     // overheard, addressed to another custodian
+
+    if (sink) {
+        uint64_t id = ((uint64_t)chunk->getSource() << 32) | chunk->getSequence();
+        if (delivered.insert(id).second) {
+            numDelivered++;
+            emit(bundleDeliveredSignal, simTime() - chunk->getCreationTime());
+        }
+        else
+            emit(duplicateDeliverySignal, 1L);
+        sendCustodyAck(sender, chunk->getSource(), chunk->getSequence());
+        return;
+    }
+
+    if (store.find(chunk->getSource(), chunk->getSequence()) == nullptr) {
+        BundleStore::Bundle bundle;
+        bundle.source = chunk->getSource();
+        bundle.sequence = chunk->getSequence();
+        bundle.priority = chunk->getPriority();
+        bundle.creationTime = chunk->getCreationTime();
+        bundle.length = chunk->getChunkLength() - B(24);
+        if (!storeBundle(bundle))
+            return;     // no custody, the sender keeps it
+        emit(custodyAcceptedSignal, 1L);
+        scheduleForward(SIMTIME_ZERO);
+    }
+    sendCustodyAck(sender, chunk->getSource(), chunk->getSequence());
+}
+
+void SwarmDtnApp::sendCustodyAck(const L3Address& sender, uint32_t source, uint32_t sequence)
+{
+    const auto& ack = makeShared<SwarmDtnCustodyAck>();
+    ack->setSender(sender);
+    ack->setSource(source);
+    ack->setSequence(sequence);
+    sendChunk(ack, "SwarmDtnCustodyAck");
+}
+
+void SwarmDtnApp::processCustodyAck(const Ptr<const SwarmDtnCustodyAck>& ack)
+{
+    if (ack->getSender() != self)
+        return;
+    if (BundleStore::Bundle *bundle = store.find(ack->getSource(), ack->getSequence())) {
+        store.remove(*bundle);
+        emit(bufferOccupancySignal, (long)store.getNumBundles());
+    }
+}
+
+void SwarmDtnApp::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    emit(packetReceivedSignal, packet);
+    const auto& chunk = packet->peekAtFront<Chunk>();
+    if (auto beacon = dynamicPtrCast<const SwarmDtnBeacon>(chunk))
+        processBeacon(beacon);
+    else if (auto bundle = dynamicPtrCast<const SwarmDtnBundle>(chunk))
+        processBundle(bundle, packet->getTag<L3AddressInd>()->getSrcAddress());
+    else if (auto ack = dynamicPtrCast<const SwarmDtnCustodyAck>(chunk))
+        processCustodyAck(ack);
+    else
+        throw cRuntimeError("Unknown DTN message: %s", packet->getName());
+    delete packet;
+}
+
+void SwarmDtnApp::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmDtnApp::finish()
+{
+    if (sink)
+        recordScalar("deliveredBundles", numDelivered);
+    ApplicationBase::finish();
+}
+
+void SwarmDtnApp::handleStartOperation(LifecycleOperation *operation)
+{
+    NetworkInterface *ie = interfaceTable->findInterfaceByName(par("interfaceName"));
+    if (ie == nullptr)
+        throw cRuntimeError("Interface '%s' not found", par("interfaceName").stringValue());
+    self = ie->getProtocolData<Ipv4InterfaceData>()->getIPAddress();
+    destAddress = L3AddressResolver().resolve(par("destAddress"));
+
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), port);
+    socket.setMulticastOutputInterface(ie->getInterfaceId());
+    socket.setMulticastLoop(false);
+
+    simtime_t start = std::max(startTime, simTime());
+    if (stopTime < SIMTIME_ZERO || start < stopTime) {
+        if (!sink)
+            scheduleAt(start, bundleTimer);
+        scheduleAt(start + par("beaconInterval"), beaconTimer);
+    }
+}
+
+void SwarmDtnApp::clearState()
+{
+    cancelEvent(bundleTimer);
+    cancelEvent(beaconTimer);
+    cancelEvent(forwardTimer);
+    store.setCapacity(store.getCapacity());
+    neighbors.clear();
+    gcsEncounterTime = SIMTIME_ZERO;
+}
+
+void SwarmDtnApp::handleStopOperation(LifecycleOperation *operation)
+{
+    clearState();
+    socket.close();
+}
+
+void SwarmDtnApp::handleCrashOperation(LifecycleOperation *operation)
+{
+    clearState();
+    socket.destroy();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,106 @@
+//===================================================================================
+// SWARM DTN APP - Store-carry-forward bundle layer for partitioned swarms
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMDTNAPP_H
+#define __DRONESWARM_SWARMDTNAPP_H
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "dtn/BundleStore.h"
+#include "dtn/SwarmDtn_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmDtnApp : public ApplicationBase, public UdpSocket::ICallback
+{
+  protected:
+    struct Neighbor
+    {
+        L3Address address;
+        simtime_t gcsEncounterTime;
+        simtime_t lastHeard;
+        bool gcs = false;
+    };
+
+    // parameters
+    bool sink = false;
+    L3Address destAddress;
+    int port = -1;
+    simtime_t startTime;
+    simtime_t stopTime;
+    B payloadLength;
+    simtime_t neighborTimeout;
+    simtime_t transitivePenalty;
+    simtime_t forwardInterval;
+    simtime_t retryInterval;
+
+    // context
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    L3Address self;
+    UdpSocket socket;
+    cMessage *bundleTimer = nullptr;
+    cMessage *beaconTimer = nullptr;
+    cMessage *forwardTimer = nullptr;
+
+    // state
+    BundleStore store;
+    uint32_t sequence = 0;
+    simtime_t gcsEncounterTime;         // 0: never met the GCS
+    std::unordered_map<uint32_t, Neighbor> neighbors;
+    std::unordered_set<uint64_t> delivered;     // sink: (source << 32 | sequence)
+    uint64_t numDelivered = 0;
+
+    static simsignal_t bundleCreatedSignal;
+    static simsignal_t bundleRefusedSignal;
+    static simsignal_t bundleEvictedSignal;
+    static simsignal_t bundleForwardedSignal;
+    static simsignal_t custodyAcceptedSignal;
+    static simsignal_t bufferOccupancySignal;
+    static simsignal_t bundleDeliveredSignal;
+    static simsignal_t duplicateDeliverySignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+    virtual void finish() override;
+
+    void createBundle();
+    bool storeBundle(const BundleStore::Bundle& bundle);
+    void sendBeacon();
+    void forwardBundle();
+    const Neighbor *findCustodian();
+    void scheduleForward(simtime_t delay);
+    void processBeacon(const Ptr<const SwarmDtnBeacon>& beacon);
+    void processBundle(const Ptr<const SwarmDtnBundle>& bundle, const L3Address& sender);
+    void processCustodyAck(const Ptr<const SwarmDtnCustodyAck>& ack);
+    void sendCustodyAck(const L3Address& sender, uint32_t source, uint32_t sequence);
+    void sendChunk(const Ptr<const Chunk>& chunk, const char *name);
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+    void clearState();
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmDtnApp();
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,222 @@
+//===================================================================================
+// SWARM IMAGERY APP - Windowed, paced bulk transfer of detection imagery
+//===================================================================================
+
+#include "imagery/SwarmImageryApp.h"
+
+#include "inet/common/Simsignals.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmImageryApp);
+
+simsignal_t SwarmImageryApp::retransmissionSignal = cComponent::registerSignal("retransmission");
+simsignal_t SwarmImageryApp::imageDroppedSignal = cComponent::registerSignal("imageDropped");
+simsignal_t SwarmImageryApp::imageCompletedSignal = cComponent::registerSignal("imageCompleted");
+simsignal_t SwarmImageryApp::queuedImagesSignal = cComponent::registerSignal("queuedImages");
+
+SwarmImageryApp::~SwarmImageryApp()
+{
+    cancelAndDelete(imageTimer);
+    cancelAndDelete(sendTimer);
+}
+
+void SwarmImageryApp::initialize(int stage)
+{
+    ApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        destPort = par("destPort");
+        startTime = par("startTime");
+        stopTime = par("stopTime");
+        if (stopTime >= SIMTIME_ZERO && stopTime < startTime)
+            throw cRuntimeError("Invalid startTime/stopTime parameters");
+        chunkSize = B(par("chunkSize").intValue());
+        if (chunkSize <= B(16))
+            throw cRuntimeError("chunkSize must exceed the 16 B chunk header");
+        windowSize = par("windowSize");
+        pacingRate = par("pacingRate");
+        if (pacingRate < 0)
+            throw cRuntimeError("pacingRate must not be negative");
+        rto = par("rto");
+        maxQueuedImages = par("maxQueuedImages");
+        imageTimer = new cMessage("ImageTimer", IMAGE);
+        sendTimer = new cMessage("SendTimer", SEND);
+    }
+}
+
+void SwarmImageryApp::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg == imageTimer) {
+        createImage();
+        simtime_t next = simTime() + par("imageInterval");
+        if (stopTime < SIMTIME_ZERO || next < stopTime)
+            scheduleAt(next, imageTimer);
+    }
+    else if (msg == sendTimer)
+        sendNextChunk();
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmImageryApp::createImage()
+{
+    if ((int)queue.size() >= maxQueuedImages) {
+        emit(imageDroppedSignal, 1L);
+        return;
+    }
+    B imageSize = B(par("imageSize").intValue());
+    B payloadSize = chunkSize - B(16);
+    Image image;
+    image.id = nextImageId++;
+    image.numChunks = (imageSize.get() + payloadSize.get() - 1) / payloadSize.get();
+    image.lastChunkSize = imageSize - payloadSize * (image.numChunks - 1) + B(16);
+    image.creationTime = simTime();
+    queue.push_back(image);
+    emit(queuedImagesSignal, (long)queue.size());
+    if (queue.size() == 1)
+        startTransfer();
+}
+
+void SwarmImageryApp::startTransfer()
+{
+    chunks.assign(queue.front().numChunks, UNSENT);
+    inFlight.clear();
+    numInFlight = 0;
+    numAcked = 0;
+    nextUnsent = 0;
+    transferStart = simTime();
+    scheduleSend(simTime());
+}
+
+void SwarmImageryApp::scheduleSend(simtime_t time)
+{
+    time = std::max(time, nextPacedTime);
+    if (sendTimer->isScheduled()) {
+        if (sendTimer->getArrivalTime() <= time)
+            return;
+        cancelEvent(sendTimer);
+    }
+    scheduleAt(std::max(time, simTime()), sendTimer);
+}
+
+void SwarmImageryApp::sendNextChunk()
+{
+    if (queue.empty())
+        return;
+    simtime_t now = simTime();
+    while (!inFlight.empty() && chunks[inFlight.front().index] != IN_FLIGHT)
+        inFlight.pop_front();   // acknowledged meanwhile
+
+    int index = -1;
+    if (!inFlight.empty() && now - inFlight.front().sentTime >= rto) {
+        index = inFlight.front().index;
+        inFlight.pop_front();
+        emit(retransmissionSignal, 1L);
+    }
+    else if (numInFlight < windowSize && nextUnsent < (int)chunks.size()) {
+        index = nextUnsent++;
+        chunks[index] = IN_FLIGHT;
+        numInFlight++;
+    }
+
+    if (index >= 0) {
+        sendChunk(index);
+        inFlight.push_back({(uint16_t)index, now});
+        nextPacedTime = pacingRate > 0 ? now + b(chunkSize).get() / pacingRate : now;
+        scheduleSend(nextPacedTime);
+    }
+    else if (!inFlight.empty())
+        scheduleSend(inFlight.front().sentTime + rto);  // window full: wake at the next timeout
+}
+
+void SwarmImageryApp::sendChunk(int index)
+{
+    const Image& image = queue.front();
+    const auto& chunk = makeShared<SwarmImageChunk>();
+    chunk->setImageId(image.id);
+    chunk->setChunkIndex(index);
+    chunk->setNumChunks(image.numChunks);
+    chunk->setCreationTime(image.creationTime);
+    chunk->setChunkLength(index == image.numChunks - 1 ? image.lastChunkSize : chunkSize);
+
+    auto packet = new Packet("SwarmImageChunk", chunk);
+    emit(packetSentSignal, packet);
+    socket.sendTo(packet, destAddress, destPort);
+}
+
+void SwarmImageryApp::processAck(const Ptr<const SwarmImageAck>& ack)
+{
+    if (queue.empty() || ack->getImageId() != queue.front().id || ack->getChunkIndex() >= chunks.size())
+        return;     // late ACK of a finished image
+    ChunkState& state = chunks[ack->getChunkIndex()];
+    if (state != IN_FLIGHT)
+        return;
+    state = ACKED;
+    numInFlight--;
+    numAcked++;
+    if (numAcked == (int)chunks.size()) {
+        emit(imageCompletedSignal, simTime() - transferStart);
+        queue.pop_front();
+        emit(queuedImagesSignal, (long)queue.size());
+        if (!queue.empty())
+            startTransfer();
+        else
+            cancelEvent(sendTimer);
+    }
+    else
+        scheduleSend(simTime());
+}
+
+void SwarmImageryApp::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    processAck(packet->peekAtFront<SwarmImageAck>());
+    delete packet;
+}
+
+void SwarmImageryApp::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmImageryApp::clearTransfers()
+{
+    cancelEvent(imageTimer);
+    cancelEvent(sendTimer);
+    queue.clear();
+    chunks.clear();
+    inFlight.clear();
+    numInFlight = 0;
+    nextPacedTime = SIMTIME_ZERO;
+}
+
+void SwarmImageryApp::handleStartOperation(LifecycleOperation *operation)
+{
+    destAddress = L3AddressResolver().resolve(par("destAddress"));
+
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), par("localPort"));
+
+    simtime_t start = std::max(startTime, simTime());
+    if (stopTime < SIMTIME_ZERO || start < stopTime)
+        scheduleAt(start, imageTimer);
+}
+
+void SwarmImageryApp::handleStopOperation(LifecycleOperation *operation)
+{
+    clearTransfers();
+    socket.close();
+}
+
+void SwarmImageryApp::handleCrashOperation(LifecycleOperation *operation)
+{
+    clearTransfers();
+    socket.destroy();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,101 @@
+//===================================================================================
+// SWARM IMAGERY APP - Windowed, paced bulk transfer of detection imagery
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMIMAGERYAPP_H
+#define __DRONESWARM_SWARMIMAGERYAPP_H
+
+#include <deque>
+#include <vector>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "imagery/SwarmImagery_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmImageryApp : public ApplicationBase, public UdpSocket::ICallback
+{
+  protected:
+    enum SelfMsgKinds { IMAGE = 1, SEND };
+    enum ChunkState : uint8_t { UNSENT, IN_FLIGHT, ACKED };
+
+    struct Image
+    {
+        uint32_t id = 0;
+        uint16_t numChunks = 0;
+        B lastChunkSize;
+        simtime_t creationTime;
+    };
+
+    struct SentChunk
+    {
+        uint16_t index;
+        simtime_t sentTime;
+    };
+
+    // parameters
+    L3Address destAddress;
+    int destPort = -1;
+    simtime_t startTime;
+    simtime_t stopTime;
+    B chunkSize;
+    int windowSize = 0;
+    double pacingRate = 0;
+    simtime_t rto;
+    int maxQueuedImages = 0;
+
+    // context
+    UdpSocket socket;
+    cMessage *imageTimer = nullptr;
+    cMessage *sendTimer = nullptr;
+
+    // transfer state
+    uint32_t nextImageId = 0;
+    std::deque<Image> queue;            // front is being transferred
+    std::vector<ChunkState> chunks;     // of the front image
+    std::deque<SentChunk> inFlight;     // in send order, oldest first
+    int numInFlight = 0;
+    int numAcked = 0;
+    int nextUnsent = 0;
+    simtime_t transferStart;
+    simtime_t nextPacedTime;            // earliest time the next chunk may leave
+
+    static simsignal_t retransmissionSignal;
+    static simsignal_t imageDroppedSignal;
+    static simsignal_t imageCompletedSignal;
+    static simsignal_t queuedImagesSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+
+    void createImage();
+    void startTransfer();
+    void sendNextChunk();
+    void sendChunk(int index);
+    void processAck(const Ptr<const SwarmImageAck>& ack);
+    void scheduleSend(simtime_t time);
+    void clearTransfers();
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmImageryApp();
+};
+
+} // namespace droneswarm
+
+#endif
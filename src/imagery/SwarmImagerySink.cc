@@ -0,0 +1,92 @@
+//===================================================================================
+// SWARM IMAGERY SINK - GCS side of the imagery transfer
+//===================================================================================
+
+#include "imagery/SwarmImagerySink.h"
+
+#include "inet/common/Simsignals.h"
+#include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/transportlayer/common/L4PortTag_m.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmImagerySink);
+
+simsignal_t SwarmImagerySink::duplicateChunkSignal = cComponent::registerSignal("duplicateChunk");
+simsignal_t SwarmImagerySink::imageLatencySignal = cComponent::registerSignal("imageLatency");
+simsignal_t SwarmImagerySink::goodputSignal = cComponent::registerSignal("goodput");
+
+void SwarmImagerySink::handleMessageWhenUp(cMessage *msg)
+{
+    if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmImagerySink::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    emit(packetReceivedSignal, packet);
+    const auto& chunk = packet->peekAtFront<SwarmImageChunk>();
+    L3Address source = packet->getTag<L3AddressInd>()->getSrcAddress();
+    int sourcePort = packet->getTag<L4PortInd>()->getSrcPort();
+    uint16_t index = chunk->getChunkIndex();
+
+    // always ACK, the previous ACK may have been lost
+    sendAck(source, sourcePort, chunk->getImageId(), index);
+
+    Reassembly& image = images[ImageKey(source, chunk->getImageId())];
+    if (!image.complete && image.received.empty())
+        image.received.resize(chunk->getNumChunks());
+    if (image.complete || index >= image.received.size() || image.received[index])
+        emit(duplicateChunkSignal, 1L);
+    else {
+        image.received[index] = true;
+        image.numReceived++;
+        emit(goodputSignal, (long)b(chunk->getChunkLength() - B(16)).get());
+        if (image.numReceived == (int)image.received.size()) {
+            image.complete = true;
+            image.received.clear();
+            image.received.shrink_to_fit();
+            emit(imageLatencySignal, simTime() - chunk->getCreationTime());
+        }
+    }
+    delete packet;
+}
+
+void SwarmImagerySink::sendAck(const L3Address& address, int port, uint32_t imageId, uint16_t chunkIndex)
+{
+    const auto& ack = makeShared<SwarmImageAck>();
+    ack->setImageId(imageId);
+    ack->setChunkIndex(chunkIndex);
+    auto packet = new Packet("SwarmImageAck", ack);
+    emit(packetSentSignal, packet);
+    socket.sendTo(packet, address, port);
+}
+
+void SwarmImagerySink::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmImagerySink::handleStartOperation(LifecycleOperation *operation)
+{
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), par("localPort"));
+}
+
+void SwarmImagerySink::handleStopOperation(LifecycleOperation *operation)
+{
+    images.clear();
+    socket.close();
+}
+
+void SwarmImagerySink::handleCrashOperation(LifecycleOperation *operation)
+{
+    images.clear();
+    socket.destroy();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,58 @@
+//===================================================================================
+// SWARM IMAGERY SINK - GCS side of the imagery transfer
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMIMAGERYSINK_H
+#define __DRONESWARM_SWARMIMAGERYSINK_H
+
+#include <map>
+#include <vector>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "imagery/SwarmImagery_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmImagerySink : public ApplicationBase, public UdpSocket::ICallback
+{
+  protected:
+    typedef std::pair<L3Address, uint32_t> ImageKey;   // source, imageId
+
+    struct Reassembly
+    {
+        std::vector<bool> received;     // cleared once complete
+        int numReceived = 0;
+        bool complete = false;
+    };
+
+    UdpSocket socket;
+    std::map<ImageKey, Reassembly> images;
+
+    static simsignal_t duplicateChunkSignal;
+    static simsignal_t imageLatencySignal;
+    static simsignal_t goodputSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+
+    void sendAck(const L3Address& address, int port, uint32_t imageId, uint16_t chunkIndex);
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,76 @@
+//===================================================================================
+// LINK TABLE - Calibrated per-link delivery probability and delay
+//===================================================================================
+
+#include "linklayer/LinkTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace droneswarm {
+
+static std::vector<double> parseValues(const cXMLElement *root, const char *name)
+{
+    const cXMLElement *element = root->getFirstChildWithTag(name);
+    if (element == nullptr || element->getNodeValue() == nullptr)
+        throw cRuntimeError("Link table: missing <%s> at %s", name, root->getSourceLocation());
+    return cStringTokenizer(element->getNodeValue()).asDoubleVector();
+}
+
+void LinkTable::parse(const cXMLElement *root)
+{
+    const char *versionAttribute = root->getAttribute("version");
+    version = versionAttribute != nullptr ? versionAttribute : "";
+    distanceEdges = parseValues(root, "distance");
+    altitudeEdges = root->getFirstChildWithTag("altitude") != nullptr ? parseValues(root, "altitude") : std::vector<double>{INFINITY};
+    loadEdges = parseValues(root, "load");
+    for (auto edges : {&distanceEdges, &altitudeEdges, &loadEdges}) {
+        if (edges->empty())
+            throw cRuntimeError("Link table: empty bin edges at %s", root->getSourceLocation());
+        if (!std::is_sorted(edges->begin(), edges->end()))
+            throw cRuntimeError("Link table: bin edges must be ascending at %s", root->getSourceLocation());
+    }
+
+    cells = parseCells(root);
+    const cXMLElement *unicast = root->getFirstChildWithTag("unicast");
+    unicastCells = unicast != nullptr ? parseCells(unicast) : std::vector<Cell>();
+}
+
+std::vector<LinkTable::Cell> LinkTable::parseCells(const cXMLElement *element) const
+{
+    auto success = parseValues(element, "success");
+    auto delay = parseValues(element, "delay");
+    auto delayStdDev = parseValues(element, "delayStdDev");
+    size_t size = distanceEdges.size() * altitudeEdges.size() * loadEdges.size();
+    if (success.size() != size || delay.size() != size || delayStdDev.size() != size)
+        throw cRuntimeError("Link table: expected %d values per table (%d distance × %d altitude × %d load bins) at %s",
+                (int)size, (int)distanceEdges.size(), (int)altitudeEdges.size(), (int)loadEdges.size(), element->getSourceLocation());
+
+    std::vector<Cell> result(size);
+    for (size_t i = 0; i < size; i++) {
+        if (success[i] < 0 || success[i] > 1 || delay[i] < 0 || delayStdDev[i] < 0)
+            throw cRuntimeError("Link table: value %d out of range at %s", (int)i, element->getSourceLocation());
+        result[i].success = success[i];
+        result[i].delay = delay[i];
+        result[i].delayStdDev = delayStdDev[i];
+    }
+    return result;
+}
+
+int LinkTable::findBin(const std::vector<double>& edges, double value)
+{
+    return std::lower_bound(edges.begin(), edges.end(), value) - edges.begin();
+}
+
+const LinkTable::Cell *LinkTable::lookup(double distance, double altitudeDifference, int load, bool unicast) const
+{
+    int distanceBin = findBin(distanceEdges, distance);
+    if (distanceBin == (int)distanceEdges.size())
+        return nullptr;
+    int altitudeBin = std::min(findBin(altitudeEdges, std::abs(altitudeDifference)), (int)altitudeEdges.size() - 1);
+    int loadBin = std::min(findBin(loadEdges, load), (int)loadEdges.size() - 1);
+    const auto& table = unicast && !unicastCells.empty() ? unicastCells : cells;
+    return &table[(distanceBin * altitudeEdges.size() + altitudeBin) * loadEdges.size() + loadBin];
+}
+
+} // namespace droneswarm
@@ -0,0 +1,72 @@
+//===================================================================================
+// LINK TABLE - Calibrated per-link delivery probability and delay
+//===================================================================================
+// Lookup table over (distance, altitude difference, load) bins, load being
+// the number of other senders active around the transmitter. Bins are given
+// by their upper edges; a distance beyond the last edge is out of range, an
+// altitude difference or load beyond the last edge uses the last bin. The
+// altitude axis is optional. Unicast frames (delivered if any MAC retry
+// gets through) use the optional <unicast> cells, broadcast frames and
+// tables without them the top-level ones. XML format (values
+// distance-major, then altitude, then load):
+//
+//   <linkTable version="...">              <!-- hash of the radio setup -->
+//     <radio>...</radio>                   <!-- parameters it was fitted for -->
+//     <distance>100 200 ...</distance>     <!-- m -->
+//     <altitude>20 40 ...</altitude>       <!-- |Δz|, m -->
+//     <load>0 1 2 4 ...</load>             <!-- concurrent senders -->
+//     <success>...</success>               <!-- delivery probability -->
+//     <delay>...</delay>                   <!-- mean MAC delay, s -->
+//     <delayStdDev>...</delayStdDev>       <!-- s -->
+//     <unicast>                            <!-- same bins -->
+//       <success>...</success> <delay>...</delay> <delayStdDev>...</delayStdDev>
+//     </unicast>
+//   </linkTable>
+//===================================================================================
+
+#ifndef __DRONESWARM_LINKTABLE_H
+#define __DRONESWARM_LINKTABLE_H
+
+#include <string>
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class LinkTable
+{
+  public:
+    struct Cell
+    {
+        double success = 0;
+        simtime_t delay;
+        simtime_t delayStdDev;
+    };
+
+  protected:
+    std::string version;
+    std::vector<double> distanceEdges;
+    std::vector<double> altitudeEdges;      // a single unbounded bin if absent
+    std::vector<double> loadEdges;
+    std::vector<Cell> cells;
+    std::vector<Cell> unicastCells;         // empty if absent
+
+    static int findBin(const std::vector<double>& edges, double value);
+    std::vector<Cell> parseCells(const cXMLElement *element) const;
+
+  public:
+    void parse(const cXMLElement *root);
+
+    const std::string& getVersion() const { return version; }
+    double getMaxDistance() const { return distanceEdges.empty() ? 0 : distanceEdges.back(); }
+
+    // nullptr if the distance is out of range
+    const Cell *lookup(double distance, double altitudeDifference, int load, bool unicast) const;
+};
+
+} // namespace droneswarm
+
+#endif
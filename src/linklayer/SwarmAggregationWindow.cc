@@ -0,0 +1,96 @@
+//===================================================================================
+// SWARM AGGREGATION WINDOW - Holds unicast frames so the MAC can aggregate
+//===================================================================================
+
+#include "linklayer/SwarmAggregationWindow.h"
+
+#include <algorithm>
+
+#include "inet/common/ProtocolTag_m.h"
+#include "inet/linklayer/common/MacAddressTag_m.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/ipv4/Ipv4Header_m.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmAggregationWindow);
+
+simsignal_t SwarmAggregationWindow::holdingDelaySignal = cComponent::registerSignal("holdingDelay");
+simsignal_t SwarmAggregationWindow::batchSizeSignal = cComponent::registerSignal("batchSize");
+
+SwarmAggregationWindow::~SwarmAggregationWindow()
+{
+    for (auto& entry : batches) {
+        cancelAndDelete(entry.second.timer);
+        for (auto packet : entry.second.packets)
+            delete packet;
+    }
+}
+
+void SwarmAggregationWindow::initialize()
+{
+    window = par("window");
+    maxFrames = par("maxFrames");
+    maxBytes = B(par("maxBytes"));
+}
+
+bool SwarmAggregationWindow::isHeld(Packet *packet)
+{
+    if (window == 0)
+        return false;
+    auto macAddressReq = packet->findTag<MacAddressReq>();
+    auto protocolTag = packet->findTag<PacketProtocolTag>();
+    if (macAddressReq == nullptr || macAddressReq->getDestAddress().isMulticast() || macAddressReq->getDestAddress().isBroadcast()
+            || protocolTag == nullptr || protocolTag->getProtocol() != &Protocol::ipv4)
+        return false;
+    if (!destAddressesResolved) {
+        // resolved on first use: addresses are assigned after initialization
+        destAddresses = L3AddressResolver().resolve(cStringTokenizer(par("destAddresses")).asVector());
+        destAddressesResolved = true;
+    }
+    if (destAddresses.empty())
+        return true;
+    L3Address destAddress = packet->peekAtFront<Ipv4Header>()->getDestAddress();
+    return std::find(destAddresses.begin(), destAddresses.end(), destAddress) != destAddresses.end();
+}
+
+void SwarmAggregationWindow::handleMessage(cMessage *msg)
+{
+    if (msg->isSelfMessage()) {
+        release(*static_cast<MacAddress *>(msg->getContextPointer()));
+        return;
+    }
+    auto packet = check_and_cast<Packet *>(msg);
+    if (!isHeld(packet)) {
+        send(packet, "out");
+        return;
+    }
+    auto it = batches.emplace(packet->getTag<MacAddressReq>()->getDestAddress(), Batch()).first;
+    Batch& batch = it->second;
+    if (batch.timer == nullptr) {
+        batch.timer = new cMessage("AggregationWindow");
+        batch.timer->setContextPointer(const_cast<MacAddress *>(&it->first));
+    }
+    batch.packets.push_back(packet);
+    batch.length += packet->getTotalLength();
+    if ((int)batch.packets.size() >= maxFrames || batch.length >= maxBytes)
+        release(it->first);
+    else if (!batch.timer->isScheduled())
+        scheduleAfter(window, batch.timer);
+}
+
+void SwarmAggregationWindow::release(const MacAddress& nextHop)
+{
+    Batch& batch = batches[nextHop];
+    cancelEvent(batch.timer);
+    EV_DEBUG << "Releasing " << batch.packets.size() << " datagrams for " << nextHop << endl;
+    emit(batchSizeSignal, (long)batch.packets.size());
+    for (auto packet : batch.packets) {
+        emit(holdingDelaySignal, simTime() - packet->getArrivalTime());
+        send(packet, "out");
+    }
+    batch.packets.clear();
+    batch.length = B(0);
+}
+
+} // namespace droneswarm
@@ -0,0 +1,55 @@
+//===================================================================================
+// SWARM AGGREGATION WINDOW - Holds unicast frames so the MAC can aggregate
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMAGGREGATIONWINDOW_H
+#define __DRONESWARM_SWARMAGGREGATIONWINDOW_H
+
+#include <map>
+#include <vector>
+
+#include "inet/common/packet/Packet.h"
+#include "inet/linklayer/common/MacAddress.h"
+#include "inet/networklayer/common/L3Address.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmAggregationWindow : public cSimpleModule
+{
+  protected:
+    struct Batch
+    {
+        std::vector<Packet *> packets;
+        B length = B(0);
+        cMessage *timer = nullptr;
+    };
+
+    // parameters
+    simtime_t window;
+    int maxFrames = 0;
+    B maxBytes = B(0);
+    std::vector<L3Address> destAddresses;
+    bool destAddressesResolved = false;
+
+    // state
+    std::map<MacAddress, Batch> batches;
+
+    static simsignal_t holdingDelaySignal;
+    static simsignal_t batchSizeSignal;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+
+    bool isHeld(Packet *packet);
+    void release(const MacAddress& nextHop);
+
+  public:
+    virtual ~SwarmAggregationWindow();
+};
+
+} // namespace droneswarm
+
+#endif
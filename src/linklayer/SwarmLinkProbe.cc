@@ -0,0 +1,221 @@
+//===================================================================================
+// SWARM LINK PROBE - Per-link samples from detailed runs for link tables
+//===================================================================================
+
+#include "linklayer/SwarmLinkProbe.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "inet/common/ModuleAccess.h"
+#include "inet/common/Simsignals.h"
+#include "inet/common/packet/Packet.h"
+#include "inet/linklayer/base/MacProtocolBase.h"
+#include "inet/linklayer/common/MacAddressTag_m.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/common/NetworkInterface.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmLinkProbe);
+
+SwarmLinkProbe::~SwarmLinkProbe()
+{
+    if (log != nullptr)
+        fclose(log);
+}
+
+void SwarmLinkProbe::initialize(int stage)
+{
+    cSimpleModule::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        maxDistance = par("maxDistance");
+        loadRange = par("loadRange");
+        loadWindow = par("loadWindow");
+        frameTimeout = par("frameTimeout");
+
+        cModule *network = getParentModule();
+        for (const char *name : {par("droneModule").stringValue(), par("gcsModule").stringValue()}) {
+            int size = network->getSubmoduleVectorSize(name);
+            for (int i = 0; i < size; i++) {
+                cModule *node = network->getSubmodule(name, i);
+                nodeIndex[node] = nodes.size();
+                nodes.push_back(check_and_cast<IMobility *>(node->getSubmodule("mobility")));
+            }
+        }
+        lastTransmissionTime.assign(nodes.size(), -1);
+
+        const char *logFile = par("logFile");
+        log = fopen(logFile, "wb");
+        if (log == nullptr)
+            throw cRuntimeError("Cannot open link log '%s'", logFile);
+        writeHeader();
+
+        network->subscribe(packetReceivedFromUpperSignal, this);
+        network->subscribe(packetSentToLowerSignal, this);
+        network->subscribe(packetSentToUpperSignal, this);
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // MAC addresses are assigned during the earlier stages
+        for (const auto& entry : nodeIndex) {
+            IInterfaceTable *interfaceTable = L3AddressResolver().findInterfaceTableOf(entry.first);
+            for (int i = 0; interfaceTable != nullptr && i < interfaceTable->getNumInterfaces(); i++) {
+                const MacAddress& address = interfaceTable->getInterface(i)->getMacAddress();
+                if (!address.isUnspecified())
+                    macNodeIndex[address] = entry.second;
+            }
+        }
+    }
+}
+
+void SwarmLinkProbe::appendParameters(std::string& text, cModule *module, bool recurse) const
+{
+    std::string path = module->getFullPath().substr(getParentModule()->getFullPath().length() + 1);
+    text += path + ".typename=" + module->getNedTypeName() + "\n";
+    for (int i = 0; i < module->getNumParams(); i++) {
+        cPar& parameter = module->par(i);
+        if (strcmp(parameter.getName(), "displayStringTextFormat") != 0)
+            text += path + "." + parameter.getName() + "=" + parameter.str() + "\n";
+    }
+    if (recurse)
+        for (cModule::SubmoduleIterator it(module); !it.end(); ++it)
+            appendParameters(text, *it, false);
+}
+
+void SwarmLinkProbe::writeHeader()
+{
+    std::string text;
+    cStringTokenizer tokenizer(par("radioModules"));
+    while (const char *path = tokenizer.nextToken()) {
+        cModule *module = getParentModule()->getModuleByPath(path);
+        if (module == nullptr)
+            throw cRuntimeError("Radio module '%s' not found", path);
+        appendParameters(text, module, true);
+    }
+    uint8_t prefix[10] = {'S', 'W', 'L', 'K', FORMAT_VERSION & 0xFF, FORMAT_VERSION >> 8};
+    uint32_t length = text.length();
+    for (int i = 0; i < 4; i++)
+        prefix[6 + i] = (length >> (8 * i)) & 0xFF;
+    fwrite(prefix, 1, sizeof(prefix), log);
+    fwrite(text.data(), 1, length, log);
+}
+
+int SwarmLinkProbe::findNode(cComponent *source) const
+{
+    auto it = nodeIndex.find(getContainingNode(check_and_cast<cModule *>(source)));
+    return it == nodeIndex.end() ? -1 : it->second;
+}
+
+void SwarmLinkProbe::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details)
+{
+    if (dynamic_cast<MacProtocolBase *>(source) == nullptr)
+        return;
+    int node = findNode(source);
+    if (node == -1)
+        return;
+    auto packet = check_and_cast<Packet *>(obj);
+    if (signalID == packetReceivedFromUpperSignal) {
+        if (auto macAddressReq = packet->findTag<MacAddressReq>())
+            frameQueued(node, packet->getTreeId(), macAddressReq->getDestAddress());
+    }
+    else if (signalID == packetSentToLowerSignal)
+        lastTransmissionTime[node] = simTime();
+    else if (signalID == packetSentToUpperSignal)
+        frameReceived(node, packet->getTreeId());
+}
+
+void SwarmLinkProbe::frameQueued(int sender, long treeId, const MacAddress& dest)
+{
+    simtime_t now = simTime();
+    flush(now - frameTimeout);
+    if (frames.find(treeId) != frames.end())
+        return;     // same packet on another interface of the sender
+
+    int destNode = -1;
+    bool unicast = !dest.isBroadcast() && !dest.isMulticast();
+    if (unicast) {
+        auto it = macNodeIndex.find(dest);
+        if (it == macNodeIndex.end())
+            return;
+        destNode = it->second;
+    }
+
+    const Coord& position = nodes[sender]->getCurrentPosition();
+    Frame& frame = frames[treeId];
+    frame.sendTime = now;
+    frame.unicast = unicast;
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        if (i == sender)
+            continue;
+        const Coord& other = nodes[i]->getCurrentPosition();
+        double distance = other.distance(position);
+        if (lastTransmissionTime[i] >= now - loadWindow && distance <= loadRange)
+            frame.load++;
+        if (distance <= maxDistance && (!unicast || i == destNode)) {
+            Sample sample;
+            sample.receiver = i;
+            sample.distance = distance;
+            sample.altitudeDifference = other.z - position.z;
+            frame.samples.push_back(sample);
+        }
+    }
+    frameOrder.push_back(treeId);
+}
+
+void SwarmLinkProbe::frameReceived(int receiver, long treeId)
+{
+    auto it = frames.find(treeId);
+    if (it == frames.end())
+        return;
+    Frame& frame = it->second;
+    for (auto& sample : frame.samples) {
+        if (sample.receiver == receiver && !sample.success) {
+            sample.success = true;      // first copy only (retransmissions, multi-interface receivers)
+            sample.delay = simTime() - frame.sendTime;
+            break;
+        }
+    }
+}
+
+void SwarmLinkProbe::writeSample(const Frame& frame, const Sample& sample)
+{
+    auto clamp = [] (double value, double low, double high) { return (long)std::round(std::min(std::max(value, low), high)); };
+    uint16_t distance = clamp(sample.distance * 10, 0, UINT16_MAX);
+    int16_t altitudeDifference = clamp(sample.altitudeDifference * 10, INT16_MIN, INT16_MAX);
+    uint16_t load = std::min(frame.load, (int)UINT16_MAX);
+    uint32_t delay = sample.success ? clamp(sample.delay.dbl() * 1e6, 0, UINT32_MAX) : 0;
+    uint8_t record[12] = {
+        (uint8_t)(distance & 0xFF), (uint8_t)(distance >> 8),
+        (uint8_t)((uint16_t)altitudeDifference & 0xFF), (uint8_t)((uint16_t)altitudeDifference >> 8),
+        (uint8_t)(load & 0xFF), (uint8_t)(load >> 8),
+        (uint8_t)sample.success, (uint8_t)frame.unicast,
+        (uint8_t)(delay & 0xFF), (uint8_t)((delay >> 8) & 0xFF), (uint8_t)((delay >> 16) & 0xFF), (uint8_t)(delay >> 24)
+    };
+    fwrite(record, 1, sizeof(record), log);
+    numSamples++;
+}
+
+void SwarmLinkProbe::flush(simtime_t olderThan)
+{
+    while (!frameOrder.empty()) {
+        auto it = frames.find(frameOrder.front());
+        if (it != frames.end()) {
+            if (it->second.sendTime > olderThan)
+                break;
+            for (const auto& sample : it->second.samples)
+                writeSample(it->second, sample);
+            frames.erase(it);
+        }
+        frameOrder.pop_front();
+    }
+}
+
+void SwarmLinkProbe::finish()
+{
+    flush(SIMTIME_MAX);
+    fflush(log);
+    recordScalar("linkSamples", numSamples);
+}
+
+} // namespace droneswarm
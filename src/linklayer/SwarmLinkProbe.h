@@ -0,0 +1,83 @@
+//===================================================================================
+// SWARM LINK PROBE - Per-link samples from detailed runs for link tables
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMLINKPROBE_H
+#define __DRONESWARM_SWARMLINKPROBE_H
+
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+#include "inet/linklayer/common/MacAddress.h"
+#include "inet/mobility/contract/IMobility.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmLinkProbe : public cSimpleModule, public cListener
+{
+  protected:
+    static const uint16_t FORMAT_VERSION = 2;
+
+    struct Sample
+    {
+        int receiver = -1;
+        double distance = 0;
+        double altitudeDifference = 0;
+        bool success = false;
+        simtime_t delay;
+    };
+
+    struct Frame
+    {
+        simtime_t sendTime;
+        int load = 0;
+        bool unicast = false;
+        std::vector<Sample> samples;
+    };
+
+    // parameters
+    double maxDistance = 0;
+    double loadRange = 0;
+    simtime_t loadWindow;
+    simtime_t frameTimeout;
+
+    // context
+    std::map<cModule *, int> nodeIndex;
+    std::map<MacAddress, int> macNodeIndex;
+    std::vector<IMobility *> nodes;
+    FILE *log = nullptr;
+
+    // state
+    std::vector<simtime_t> lastTransmissionTime;        // per node, last frame sent to a radio
+    std::unordered_map<long, Frame> frames;             // by packet tree id
+    std::deque<long> frameOrder;
+    long numSamples = 0;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void finish() override;
+    virtual void handleMessage(cMessage *msg) override { throw cRuntimeError("This module receives no messages"); }
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) override;
+
+    int findNode(cComponent *source) const;
+    void writeHeader();
+    void appendParameters(std::string& text, cModule *module, bool recurse) const;
+    void frameQueued(int sender, long treeId, const MacAddress& dest);
+    void frameReceived(int receiver, long treeId);
+    void flush(simtime_t olderThan);
+    void writeSample(const Frame& frame, const Sample& sample);
+
+  public:
+    virtual ~SwarmLinkProbe();
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,201 @@
+//===================================================================================
+// SWARM RATE CONTROL - Minstrel-like 802.11 rate control with predicted SNR
+//===================================================================================
+
+#include "linklayer/SwarmRateControl.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "inet/common/ModuleAccess.h"
+#include "inet/linklayer/ieee80211/mac/Ieee80211Frame_m.h"
+#include "inet/physicallayer/wireless/common/base/packetlevel/NarrowbandTransmitterBase.h"
+
+#include "telemetry/SwarmTelemetryApp.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmRateControl);
+
+std::map<MacAddress, int> SwarmRateControl::nodeIds;
+
+simsignal_t SwarmRateControl::airtimeSignal = cComponent::registerSignal("airtime");
+simsignal_t SwarmRateControl::goodputSignal = cComponent::registerSignal("goodput");
+
+SwarmRateControl::~SwarmRateControl()
+{
+    auto it = nodeIds.find(address);
+    if (it != nodeIds.end() && telemetry != nullptr && it->second == (int)telemetry->getNodeId())
+        nodeIds.erase(it);
+}
+
+void SwarmRateControl::initialize(int stage)
+{
+    RateControlBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        updateInterval = par("updateInterval");
+        averagingWeight = par("averagingWeight");
+        samplingRatio = par("samplingRatio");
+        maxAge = par("maxAge");
+        noiseFloor = mW(math::dBmW2mW(par("noiseFloor")));
+        snrThresholds = cStringTokenizer(par("snrThresholds")).asDoubleVector();
+        telemetry = dynamic_cast<SwarmTelemetryApp *>(getModuleByPath(par("telemetryModule")));
+        radio = check_and_cast<IRadio *>(getModuleByPath(par("radioModule")));
+        radioMedium.reference(this, "radioMediumModule", true);
+        mobility.reference(this, "mobilityModule", true);
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // the MAC address is assigned by now; the GCS sends no telemetry
+        address = getContainingNicModule(this)->getMacAddress();
+        if (telemetry != nullptr && telemetry->par("transmit").boolValue())
+            nodeIds[address] = telemetry->getNodeId();
+    }
+}
+
+void SwarmRateControl::updateModes()
+{
+    if (modeSet == modesOf)
+        return;
+    modes.clear();
+    for (auto mode = modeSet->getSlowestMode(); mode != nullptr; mode = modeSet->getFasterMode(mode))
+        modes.push_back(mode);
+    if (modes.size() != snrThresholds.size())
+        throw cRuntimeError("snrThresholds has %d values, the mode set has %d modes", (int)snrThresholds.size(), (int)modes.size());
+    modesOf = modeSet;
+    neighbors.clear();
+}
+
+int SwarmRateControl::getModeIndex(const IIeee80211Mode *mode) const
+{
+    for (int i = 0; i < (int)modes.size(); i++)
+        if (modes[i] == mode)
+            return i;
+    return -1;
+}
+
+void SwarmRateControl::updateStatistics(Neighbor& neighbor)
+{
+    if (simTime() - neighbor.lastUpdate < updateInterval)
+        return;
+    for (int i = 0; i < (int)modes.size(); i++) {
+        if (neighbor.attempts[i] == 0)
+            continue;
+        double ratio = (double)neighbor.successes[i] / neighbor.attempts[i];
+        double& probability = neighbor.probability[i];
+        probability = std::isnan(probability) ? ratio : (1 - averagingWeight) * probability + averagingWeight * ratio;
+        neighbor.attempts[i] = 0;
+        neighbor.successes[i] = 0;
+    }
+    neighbor.lastUpdate = simTime();
+}
+
+int SwarmRateControl::predictMaxMode(const MacAddress& neighborAddress) const
+{
+    int fastest = modes.size() - 1;
+    auto it = nodeIds.find(neighborAddress);
+    if (telemetry == nullptr || it == nodeIds.end())
+        return fastest;
+    auto source = telemetry->findSource(it->second);
+    if (source == nullptr || source->lastReceived < simTime() - maxAge)
+        return fastest;
+    const SwarmTelemetryState& state = source->state;
+    Coord position = state.position + state.velocity * (simTime() - state.generationTime).dbl();
+    double distance = position.distance(mobility->getCurrentPosition());
+
+    const IRadioMedium *medium = radioMedium.get();
+    Hz centerFrequency = check_and_cast<const NarrowbandTransmitterBase *>(radio->getTransmitter())->getCenterFrequency();
+    double loss = medium->getPathLoss()->computePathLoss(medium->getPropagation()->getPropagationSpeed(), centerFrequency, m(distance));
+    double snr = math::fraction2dB(unit(radio->getTransmitter()->getMaxPower() * loss / noiseFloor).get());
+    int maxMode = 0;
+    for (int i = 1; i < (int)modes.size(); i++)
+        if (snr >= snrThresholds[i])
+            maxMode = i;
+    return maxMode;
+}
+
+int SwarmRateControl::selectBest(const Neighbor& neighbor, int maxMode) const
+{
+    int best = 0;
+    double bestThroughput = -1;
+    for (int i = 0; i <= maxMode; i++) {
+        // untried modes below the predicted cap are assumed to work
+        double probability = std::isnan(neighbor.probability[i]) ? 1 : neighbor.probability[i];
+        double throughput = probability * modes[i]->getDataMode()->getNetBitrate().get();
+        if (throughput > bestThroughput) {
+            best = i;
+            bestThroughput = throughput;
+        }
+    }
+    return best;
+}
+
+const IIeee80211Mode *SwarmRateControl::getRate()
+{
+    Enter_Method("getRate");
+    if (modeSet == nullptr)
+        return currentMode;
+    updateModes();
+    auto it = neighbors.find(destination);
+    if (it == neighbors.end())
+        return currentMode;
+    Neighbor& neighbor = it->second;
+    updateStatistics(neighbor);
+
+    int maxMode = predictMaxMode(destination);
+    int best = selectBest(neighbor, maxMode);
+    int index = best;
+    if (retries > 0)
+        index = std::max(0, best - retries);
+    else {
+        int maxSample = std::min(maxMode + 1, (int)modes.size() - 1);
+        if (maxSample > best && uniform(0, 1) < samplingRatio)
+            index = intuniform(best + 1, maxSample);
+    }
+    if (modes[index] != currentMode) {
+        currentMode = modes[index];
+        emitDatarateChangedSignal();
+    }
+    return currentMode;
+}
+
+void SwarmRateControl::frameTransmitted(Packet *frame, int retryCount, bool isSuccessful, bool isGivenUp)
+{
+    Enter_Method("frameTransmitted");
+    const auto& header = frame->peekAtFront<Ieee80211MacHeader>();
+    MacAddress receiver = header->getReceiverAddress();
+    if (modeSet == nullptr || receiver.isMulticast())
+        return;
+    updateModes();
+    int index = getModeIndex(currentMode);      // the mode of this attempt
+    if (index == -1)
+        return;
+
+    Neighbor& neighbor = neighbors[receiver];
+    if (neighbor.probability.empty()) {
+        neighbor.probability.assign(modes.size(), NAN);
+        neighbor.attempts.assign(modes.size(), 0);
+        neighbor.successes.assign(modes.size(), 0);
+        neighbor.lastUpdate = simTime();
+    }
+    neighbor.attempts[index]++;
+    if (isSuccessful)
+        neighbor.successes[index]++;
+
+    simtime_t airtime = currentMode->getDuration(frame->getDataLength());
+    neighbor.frameAirtime += airtime;
+    emit(airtimeSignal, airtime);
+    if (isSuccessful) {
+        b payload = frame->getDataLength() - header->getChunkLength();
+        emit(goodputSignal, payload.get() / neighbor.frameAirtime.dbl());
+    }
+    if (isSuccessful || isGivenUp) {
+        neighbor.frameAirtime = 0;
+        retries = 0;
+    }
+    else
+        retries = retryCount + 1;
+    destination = receiver;
+}
+
+} // namespace droneswarm
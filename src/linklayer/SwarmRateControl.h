@@ -0,0 +1,90 @@
+//===================================================================================
+// SWARM RATE CONTROL - Minstrel-like 802.11 rate control with predicted SNR
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMRATECONTROL_H
+#define __DRONESWARM_SWARMRATECONTROL_H
+
+#include <map>
+#include <vector>
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/linklayer/common/MacAddress.h"
+#include "inet/linklayer/ieee80211/mac/ratecontrol/RateControlBase.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadioMedium.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::ieee80211;
+using namespace inet::physicallayer;
+
+class SwarmTelemetryApp;
+
+class SwarmRateControl : public RateControlBase
+{
+  protected:
+    // per neighbor, per mode
+    struct Neighbor
+    {
+        std::vector<double> probability;    // EWMA success, NaN until tried
+        std::vector<int> attempts;          // in the current interval
+        std::vector<int> successes;
+        simtime_t lastUpdate;
+        simtime_t frameAirtime;             // all attempts of the frame in progress
+    };
+
+    // telemetry node id of each MAC with a telemetry-sending host
+    static std::map<MacAddress, int> nodeIds;
+
+    // parameters
+    simtime_t updateInterval;
+    double averagingWeight = 0;
+    double samplingRatio = 0;
+    simtime_t maxAge;
+    W noiseFloor = W(0);
+    std::vector<double> snrThresholds;
+
+    // context
+    SwarmTelemetryApp *telemetry = nullptr;
+    IRadio *radio = nullptr;
+    ModuleRefByPar<IRadioMedium> radioMedium;
+    ModuleRefByPar<IMobility> mobility;
+    MacAddress address;
+
+    // state
+    const Ieee80211ModeSet *modesOf = nullptr;
+    std::vector<const IIeee80211Mode *> modes;  // ascending bitrate
+    std::map<MacAddress, Neighbor> neighbors;
+    MacAddress destination;                     // receiver of the frame being sent
+    int retries = 0;
+
+    static simsignal_t airtimeSignal;
+    static simsignal_t goodputSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+
+    void updateModes();
+    int getModeIndex(const IIeee80211Mode *mode) const;
+    void updateStatistics(Neighbor& neighbor);
+    int predictMaxMode(const MacAddress& neighborAddress) const;
+    int selectBest(const Neighbor& neighbor, int maxMode) const;
+
+  public:
+    virtual ~SwarmRateControl();
+
+    // receiver of the next getRate() (SwarmRateSelection)
+    void setDestination(const MacAddress& receiver) { destination = receiver; }
+
+    virtual const IIeee80211Mode *getRate() override;
+    virtual void frameTransmitted(Packet *frame, int retryCount, bool isSuccessful, bool isGivenUp) override;
+    virtual void frameReceived(Packet *frame) override {}
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,22 @@
+//===================================================================================
+// SWARM RATE SELECTION - Hands the frame's receiver to SwarmRateControl
+//===================================================================================
+
+#include "linklayer/SwarmRateSelection.h"
+
+#include "linklayer/SwarmRateControl.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmRateSelection);
+
+const IIeee80211Mode *SwarmRateSelection::computeDataOrMgmtFrameMode(const Ptr<const Ieee80211DataOrMgmtHeader>& dataOrMgmtHeader)
+{
+    MacAddress receiver = dataOrMgmtHeader->getReceiverAddress();
+    if (auto rateControl = dynamic_cast<SwarmRateControl *>(dataOrMgmtRateControl))
+        if (!receiver.isMulticast())
+            rateControl->setDestination(receiver);
+    return RateSelection::computeDataOrMgmtFrameMode(dataOrMgmtHeader);
+}
+
+} // namespace droneswarm
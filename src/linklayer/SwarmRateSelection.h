@@ -0,0 +1,24 @@
+//===================================================================================
+// SWARM RATE SELECTION - Hands the frame's receiver to SwarmRateControl
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMRATESELECTION_H
+#define __DRONESWARM_SWARMRATESELECTION_H
+
+#include "inet/linklayer/ieee80211/mac/rateselection/RateSelection.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::ieee80211;
+using namespace inet::physicallayer;
+
+class SwarmRateSelection : public RateSelection
+{
+  protected:
+    virtual const IIeee80211Mode *computeDataOrMgmtFrameMode(const Ptr<const Ieee80211DataOrMgmtHeader>& dataOrMgmtHeader) override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,137 @@
+//===================================================================================
+// SWARM STATISTICAL MAC - Abstract link layer from calibrated link tables
+//===================================================================================
+
+#include "linklayer/SwarmStatisticalMac.h"
+
+#include "inet/common/ModuleAccess.h"
+#include "inet/common/ProtocolGroup.h"
+#include "inet/common/ProtocolTag_m.h"
+#include "inet/common/Simsignals.h"
+#include "inet/linklayer/common/InterfaceTag_m.h"
+#include "inet/linklayer/common/MacAddressTag_m.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmStatisticalMac);
+
+std::map<MacAddress, SwarmStatisticalMac *> SwarmStatisticalMac::macs;
+
+simsignal_t SwarmStatisticalMac::loadSignal = cComponent::registerSignal("load");
+
+SwarmStatisticalMac::~SwarmStatisticalMac()
+{
+    for (auto it = macs.begin(); it != macs.end(); ++it) {
+        if (it->second == this) {
+            macs.erase(it);
+            break;
+        }
+    }
+}
+
+void SwarmStatisticalMac::initialize(int stage)
+{
+    MacProtocolBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        linkTable.parse(par("linkTable"));
+        const char *requiredTableVersion = par("requiredTableVersion");
+        if (*requiredTableVersion && linkTable.getVersion() != requiredTableVersion)
+            throw cRuntimeError("Link table version '%s' differs from the required '%s'", linkTable.getVersion().c_str(), requiredTableVersion);
+        EV_INFO << "Link table version '" << linkTable.getVersion() << "'" << endl;
+        loadRange = par("loadRange");
+        loadWindow = par("loadWindow");
+        mobility = check_and_cast<IMobility *>(getContainingNode(this)->getSubmodule("mobility"));
+    }
+    else if (stage == INITSTAGE_LINK_LAYER) {
+        MacAddress address = networkInterface->getMacAddress();
+        if (!macs.insert({address, this}).second)
+            throw cRuntimeError("Duplicate MAC address %s", address.str().c_str());
+    }
+}
+
+void SwarmStatisticalMac::configureNetworkInterface()
+{
+    const char *address = par("address");
+    networkInterface->setMacAddress(!strcmp(address, "auto") ? MacAddress::generateAutoAddress() : MacAddress(address));
+    networkInterface->setInterfaceToken(networkInterface->getMacAddress().formInterfaceIdentifier());
+    networkInterface->setMtu(B(par("mtu")).get());
+    networkInterface->setMulticast(true);
+    networkInterface->setBroadcast(true);
+    networkInterface->setPointToPoint(false);
+}
+
+int SwarmStatisticalMac::computeLoad(const Coord& position) const
+{
+    simtime_t since = simTime() - loadWindow;
+    int load = 0;
+    for (const auto& entry : macs) {
+        const SwarmStatisticalMac *other = entry.second;
+        if (other != this && other->lastTransmissionTime >= since
+                && other->mobility->getCurrentPosition().distance(position) <= loadRange)
+            load++;
+    }
+    return load;
+}
+
+bool SwarmStatisticalMac::deliver(Packet *packet, SwarmStatisticalMac *receiver, const Coord& position, int load, bool unicast)
+{
+    const Coord& receiverPosition = receiver->mobility->getCurrentPosition();
+    const LinkTable::Cell *cell = linkTable.lookup(receiverPosition.distance(position), receiverPosition.z - position.z, load, unicast);
+    if (cell == nullptr || uniform(0, 1) >= cell->success)
+        return false;
+    simtime_t delay = cell->delayStdDev > 0 ? truncnormal(cell->delay, cell->delayStdDev) : cell->delay;
+    sendDirect(packet->dup(), delay, SIMTIME_ZERO, receiver, "lowerLayerIn");
+    return true;
+}
+
+void SwarmStatisticalMac::handleUpperPacket(Packet *packet)
+{
+    MacAddress dest = packet->getTag<MacAddressReq>()->getDestAddress();
+    const Protocol *protocol = packet->getTag<PacketProtocolTag>()->getProtocol();
+    const auto& header = makeShared<SwarmStatisticalMacHeader>();
+    header->setSrc(networkInterface->getMacAddress());
+    header->setDest(dest);
+    header->setNetworkProtocol(ProtocolGroup::getEthertypeProtocolGroup()->getProtocolNumber(protocol));
+    packet->insertAtFront(header);
+    packet->clearTags();
+    emit(packetSentToLowerSignal, packet);
+
+    const Coord& position = mobility->getCurrentPosition();
+    int load = computeLoad(position);
+    lastTransmissionTime = simTime();
+    emit(loadSignal, (long)load);
+
+    if (dest.isBroadcast() || dest.isMulticast()) {
+        for (const auto& entry : macs)
+            if (entry.second != this)
+                deliver(packet, entry.second, position, load, false);
+    }
+    else {
+        auto it = macs.find(dest);
+        if (it == macs.end() || !deliver(packet, it->second, position, load, true)) {
+            EV_INFO << "Unicast frame to " << dest << " lost" << endl;
+            // AODV needs the payload to find the broken route's destination
+            packet->popAtFront<SwarmStatisticalMacHeader>();
+            packet->addTag<PacketProtocolTag>()->setProtocol(protocol);
+            emit(linkBrokenSignal, packet);
+        }
+    }
+    delete packet;
+}
+
+void SwarmStatisticalMac::handleLowerPacket(Packet *packet)
+{
+    emit(packetReceivedFromLowerSignal, packet);
+    const auto& header = packet->popAtFront<SwarmStatisticalMacHeader>();
+    auto macAddressInd = packet->addTagIfAbsent<MacAddressInd>();
+    macAddressInd->setSrcAddress(header->getSrc());
+    macAddressInd->setDestAddress(header->getDest());
+    packet->addTagIfAbsent<InterfaceInd>()->setInterfaceId(networkInterface->getInterfaceId());
+    const Protocol *protocol = ProtocolGroup::getEthertypeProtocolGroup()->getProtocol(header->getNetworkProtocol());
+    packet->addTagIfAbsent<DispatchProtocolReq>()->setProtocol(protocol);
+    packet->addTagIfAbsent<PacketProtocolTag>()->setProtocol(protocol);
+    sendUp(packet);
+}
+
+} // namespace droneswarm
@@ -0,0 +1,54 @@
+//===================================================================================
+// SWARM STATISTICAL MAC - Abstract link layer from calibrated link tables
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMSTATISTICALMAC_H
+#define __DRONESWARM_SWARMSTATISTICALMAC_H
+
+#include <map>
+
+#include "inet/linklayer/base/MacProtocolBase.h"
+#include "inet/mobility/contract/IMobility.h"
+
+#include "linklayer/LinkTable.h"
+#include "linklayer/SwarmStatisticalMac_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmStatisticalMac : public MacProtocolBase
+{
+  protected:
+    // all MACs of the network by address, for direct delivery
+    static std::map<MacAddress, SwarmStatisticalMac *> macs;
+
+    // parameters
+    LinkTable linkTable;
+    double loadRange = 0;
+    simtime_t loadWindow;
+
+    // context
+    IMobility *mobility = nullptr;
+
+    // state
+    simtime_t lastTransmissionTime = -1;
+
+    static simsignal_t loadSignal;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual void configureNetworkInterface() override;
+    virtual void handleUpperPacket(Packet *packet) override;
+    virtual void handleLowerPacket(Packet *packet) override;
+
+    int computeLoad(const Coord& position) const;
+    bool deliver(Packet *packet, SwarmStatisticalMac *receiver, const Coord& position, int load, bool unicast);
+
+  public:
+    virtual ~SwarmStatisticalMac();
+};
+
+} // namespace droneswarm
+
+#endif
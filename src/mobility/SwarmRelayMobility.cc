@@ -0,0 +1,42 @@
+//===================================================================================
+// SWARM RELAY MOBILITY - Flies a relay drone to its planned position
+//===================================================================================
+
+#include "mobility/SwarmRelayMobility.h"
+
+#include "inet/common/ModuleAccess.h"
+
+#include "mobility/SwarmRelayPlanner.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmRelayMobility);
+
+void SwarmRelayMobility::initialize(int stage)
+{
+    MovingMobilityBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        speed = par("speed");
+        relayIndex = getContainingNode(this)->getIndex();
+        planner = check_and_cast<SwarmRelayPlanner *>(getModuleByPath(par("plannerModule")));
+    }
+}
+
+void SwarmRelayMobility::move()
+{
+    double elapsed = (simTime() - lastUpdate).dbl();
+    Coord target = planner->getRelayTarget(relayIndex, lastPosition);
+    Coord direction = target - lastPosition;
+    double distance = direction.length();
+    if (distance <= speed * elapsed) {
+        lastPosition = target;
+        lastVelocity = Coord::ZERO;
+    }
+    else {
+        lastVelocity = direction / distance * speed;
+        lastPosition += lastVelocity * elapsed;
+    }
+}
+
+} // namespace droneswarm
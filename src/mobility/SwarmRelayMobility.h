@@ -0,0 +1,33 @@
+//===================================================================================
+// SWARM RELAY MOBILITY - Flies a relay drone to its planned position
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMRELAYMOBILITY_H
+#define __DRONESWARM_SWARMRELAYMOBILITY_H
+
+#include "inet/mobility/base/MovingMobilityBase.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmRelayPlanner;
+
+class SwarmRelayMobility : public MovingMobilityBase
+{
+  protected:
+    double speed = 0;
+    int relayIndex = -1;
+    SwarmRelayPlanner *planner = nullptr;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual void move() override;
+
+  public:
+    virtual double getMaxSpeed() const override { return speed; }
+};
+
+} // namespace droneswarm
+
+#endif
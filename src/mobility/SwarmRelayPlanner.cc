@@ -0,0 +1,258 @@
+//===================================================================================
+// SWARM RELAY PLANNER - Relay drone placement from swarm connectivity
+//===================================================================================
+
+#include "mobility/SwarmRelayPlanner.h"
+
+#include <cmath>
+#include <map>
+#include <numeric>
+
+namespace droneswarm {
+
+Define_Module(SwarmRelayPlanner);
+
+simsignal_t SwarmRelayPlanner::gcsReachabilitySignal = cComponent::registerSignal("gcsReachability");
+simsignal_t SwarmRelayPlanner::componentsSignal = cComponent::registerSignal("components");
+simsignal_t SwarmRelayPlanner::relaysAssignedSignal = cComponent::registerSignal("relaysAssigned");
+simsignal_t SwarmRelayPlanner::replannedSignal = cComponent::registerSignal("replanned");
+
+SwarmRelayPlanner::~SwarmRelayPlanner()
+{
+    cancelAndDelete(updateTimer);
+}
+
+void SwarmRelayPlanner::initialize()
+{
+    communicationRange = par("communicationRange");
+    relayAltitude = par("relayAltitude");
+
+    cModule *network = getParentModule();
+    const char *droneModule = par("droneModule");
+    const char *gcsModule = par("gcsModule");
+    int numRelays = par("numRelays");
+    int numDrones = network->getSubmoduleVectorSize(droneModule);
+    if (numRelays < 0 || numRelays > numDrones)
+        throw cRuntimeError("numRelays (%d) must be between 0 and the number of drones (%d)", numRelays, numDrones);
+    for (int i = 0; i < numDrones; i++) {
+        auto mobility = check_and_cast<IMobility *>(network->getSubmodule(droneModule, i)->getSubmodule("mobility"));
+        if (i < numRelays)
+            relays.push_back(mobility);
+        else
+            nodes.push_back(mobility);
+    }
+    numGroundStations = network->getSubmoduleVectorSize(gcsModule);
+    for (int i = 0; i < numGroundStations; i++)
+        nodes.push_back(check_and_cast<IMobility *>(network->getSubmodule(gcsModule, i)->getSubmodule("mobility")));
+
+    updateTimer = new cMessage("RelayPlanUpdate");
+    scheduleAt(simTime(), updateTimer);
+}
+
+void SwarmRelayPlanner::handleMessage(cMessage *msg)
+{
+    if (msg != updateTimer)
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+    update();
+    scheduleAfter(par("updateInterval"), updateTimer);
+}
+
+void SwarmRelayPlanner::update()
+{
+    int numDrones = nodes.size() - numGroundStations;
+    positions.resize(nodes.size());
+    centroid = Coord::ZERO;
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        positions[i] = nodes[i]->getCurrentPosition();
+        if (!isGroundStation(i))
+            centroid += positions[i];
+    }
+    if (numDrones > 0)
+        centroid /= numDrones;
+
+    std::vector<int> labels;
+    int numComponents = computeComponents(positions, labels);
+    if (labels != component || isChainStretched()) {
+        component.swap(labels);
+        replan(numComponents);
+    }
+    emit(componentsSignal, (long)numComponents);
+    emit(gcsReachabilitySignal, computeReachability());
+}
+
+int SwarmRelayPlanner::computeComponents(const std::vector<Coord>& points, std::vector<int>& labels) const
+{
+    int count = points.size();
+    std::vector<int> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&] (int i) {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+
+    // range-sized grid cells: only nodes in adjacent cells can be linked
+    std::map<std::pair<long, long>, std::vector<int>> cells;
+    for (int i = 0; i < count; i++)
+        cells[{(long)std::floor(points[i].x / communicationRange), (long)std::floor(points[i].y / communicationRange)}].push_back(i);
+    for (const auto& cell : cells) {
+        for (long dx = -1; dx <= 1; dx++) {
+            for (long dy = -1; dy <= 1; dy++) {
+                auto other = cells.find({cell.first.first + dx, cell.first.second + dy});
+                if (other == cells.end())
+                    continue;
+                for (int i : cell.second)
+                    for (int j : other->second)
+                        if (i < j && points[i].distance(points[j]) <= communicationRange)
+                            parent[find(i)] = find(j);
+            }
+        }
+    }
+
+    int numComponents = 0;
+    std::vector<int> lowest(count, -1);
+    labels.resize(count);
+    for (int i = 0; i < count; i++) {
+        int root = find(i);
+        if (lowest[root] == -1) {
+            lowest[root] = i;
+            numComponents++;
+        }
+        labels[i] = lowest[root];
+    }
+    return numComponents;
+}
+
+bool SwarmRelayPlanner::isChainStretched() const
+{
+    for (const auto& slot : slots)
+        if (slot.from != -1 && slot.k == 1 && positions[slot.from].distance(positions[slot.to]) > (slot.n + 1) * communicationRange)
+            return true;
+    return false;
+}
+
+void SwarmRelayPlanner::replan(int numComponents)
+{
+    int count = positions.size();
+    int remaining = relays.size();
+    std::vector<bool> attached(count, false);   // per component label
+    std::vector<bool> connected(count, false);  // per component label: chain to the root funded
+    std::vector<double> distance(count, INFINITY);
+    std::vector<int> nearest(count, -1);
+    auto attach = [&] (int label) {
+        attached[label] = true;
+        for (int i = 0; i < count; i++) {
+            if (component[i] != label)
+                continue;
+            for (int j = 0; j < count; j++) {
+                double d = positions[i].distance(positions[j]);
+                if (!attached[component[j]] && d < distance[j]) {
+                    distance[j] = d;
+                    nearest[j] = i;
+                }
+            }
+        }
+    };
+
+    slots.clear();
+    for (int i = 0; i < count; i++) {
+        if (isGroundStation(i) && !attached[component[i]]) {
+            connected[component[i]] = true;
+            attach(component[i]);
+        }
+    }
+    // Prim: attach the component closest to the tree, fund its chain if the
+    // component it hangs off is connected and enough relays are left
+    for (int attachedComponents = 0; attachedComponents < numComponents; attachedComponents++) {
+        int next = -1;
+        for (int j = 0; j < count; j++)
+            if (!attached[component[j]] && nearest[j] != -1 && (next == -1 || distance[j] < distance[next]))
+                next = j;
+        if (next == -1)
+            break;
+        int from = nearest[next];
+        int n = (int)std::ceil(distance[next] / communicationRange) - 1;
+        if (connected[component[from]] && n <= remaining) {
+            for (int k = 1; k <= n; k++)
+                slots.push_back({from, next, k, n});
+            remaining -= n;
+            connected[component[next]] = true;
+        }
+        attach(component[next]);
+    }
+    int numChained = slots.size();
+    for (int k = 0; k < remaining; k++)
+        slots.push_back({-1, -1, k, remaining});
+
+    EV_INFO << "Relay plan: " << numComponents << " components, " << numChained << " relays on chains, " << remaining << " spare" << endl;
+    emit(replannedSignal, 1L);
+    emit(relaysAssignedSignal, (long)numChained);
+    assignRelays();
+}
+
+void SwarmRelayPlanner::assignRelays()
+{
+    // greedy nearest relay per slot, so a replan moves as few relays as possible
+    std::vector<bool> taken(relays.size(), false);
+    relaySlot.assign(relays.size(), -1);
+    for (int s = 0; s < (int)slots.size(); s++) {
+        Coord target = getSlotPosition(slots[s]);
+        int best = -1;
+        double bestDistance = INFINITY;
+        for (int r = 0; r < (int)relays.size(); r++) {
+            double d = relays[r]->getCurrentPosition().distance(target);
+            if (!taken[r] && d < bestDistance) {
+                best = r;
+                bestDistance = d;
+            }
+        }
+        taken[best] = true;
+        relaySlot[best] = s;
+    }
+}
+
+Coord SwarmRelayPlanner::getSlotPosition(const Slot& slot) const
+{
+    Coord position;
+    if (slot.from == -1) {
+        double angle = 2 * M_PI * slot.k / slot.n;
+        double radius = slot.n > 1 ? communicationRange / 2 : 0;
+        position = centroid + Coord(radius * std::cos(angle), radius * std::sin(angle), 0);
+    }
+    else {
+        const Coord& from = positions[slot.from];
+        const Coord& to = positions[slot.to];
+        position = from + (to - from) * ((double)slot.k / (slot.n + 1));
+    }
+    position.z = relayAltitude;
+    return position;
+}
+
+double SwarmRelayPlanner::computeReachability() const
+{
+    int numDrones = nodes.size() - numGroundStations;
+    if (numDrones == 0)
+        return 1;
+    std::vector<Coord> points(positions);
+    for (auto relay : relays)
+        points.push_back(relay->getCurrentPosition());
+    std::vector<int> labels;
+    computeComponents(points, labels);
+    std::vector<bool> grounded(points.size(), false);
+    for (int i = numDrones; i < (int)nodes.size(); i++)
+        grounded[labels[i]] = true;
+    int reachable = 0;
+    for (int i = 0; i < numDrones; i++)
+        if (grounded[labels[i]])
+            reachable++;
+    return (double)reachable / numDrones;
+}
+
+Coord SwarmRelayPlanner::getRelayTarget(int relayIndex, const Coord& currentPosition) const
+{
+    if (relayIndex >= (int)relaySlot.size() || relaySlot[relayIndex] == -1)
+        return currentPosition;
+    return getSlotPosition(slots[relaySlot[relayIndex]]);
+}
+
+} // namespace droneswarm
@@ -0,0 +1,74 @@
+//===================================================================================
+// SWARM RELAY PLANNER - Relay drone placement from swarm connectivity
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMRELAYPLANNER_H
+#define __DRONESWARM_SWARMRELAYPLANNER_H
+
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+#include "inet/mobility/contract/IMobility.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmRelayPlanner : public cSimpleModule
+{
+  protected:
+    // relay point k of n on the edge between two nodes; from == -1 for a spare
+    // relay, which holds position k of n on the ring around the swarm centroid
+    struct Slot
+    {
+        int from = -1;
+        int to = -1;
+        int k = 0;
+        int n = 0;
+    };
+
+    // parameters
+    double communicationRange = 0;
+    double relayAltitude = 0;
+
+    // context: nodes are the non-relay drones followed by the GCS sites
+    std::vector<IMobility *> nodes;
+    std::vector<IMobility *> relays;
+    int numGroundStations = 0;
+    cMessage *updateTimer = nullptr;
+
+    // state
+    std::vector<Coord> positions;
+    Coord centroid;
+    std::vector<int> component;         // per node: lowest node index of its component
+    std::vector<Slot> slots;
+    std::vector<int> relaySlot;         // per relay: index into slots, -1 if none
+
+    static simsignal_t gcsReachabilitySignal;
+    static simsignal_t componentsSignal;
+    static simsignal_t relaysAssignedSignal;
+    static simsignal_t replannedSignal;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+
+    void update();
+    int computeComponents(const std::vector<Coord>& points, std::vector<int>& labels) const;
+    bool isChainStretched() const;
+    void replan(int numComponents);
+    void assignRelays();
+    Coord getSlotPosition(const Slot& slot) const;
+    double computeReachability() const;
+    bool isGroundStation(int node) const { return node >= (int)nodes.size() - numGroundStations; }
+
+  public:
+    virtual ~SwarmRelayPlanner();
+
+    // target of relay drone[relayIndex]; its current position if it has none
+    Coord getRelayTarget(int relayIndex, const Coord& currentPosition) const;
+};
+
+} // namespace droneswarm
+
+#endif
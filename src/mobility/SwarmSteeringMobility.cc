@@ -0,0 +1,99 @@
+//===================================================================================
+// SWARM STEERING MOBILITY - Boresight steering for a directional antenna
+//===================================================================================
+
+#include "mobility/SwarmSteeringMobility.h"
+
+#include <cmath>
+
+#include "telemetry/SwarmTelemetryApp.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmSteeringMobility);
+
+SwarmSteeringMobility::~SwarmSteeringMobility()
+{
+    cancelAndDelete(steerTimer);
+}
+
+void SwarmSteeringMobility::initialize(int stage)
+{
+    MobilityBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        maxAge = par("maxAge");
+        cosHalfBeamWidth = std::cos(math::deg2rad(par("beamWidth").doubleValue()) / 2);
+        hostMobility.reference(this, "hostMobilityModule", true);
+        targetMobility.reference(this, "targetModule", false);
+        if (targetMobility == nullptr) {
+            const char *telemetryModule = par("telemetryModule");
+            telemetry = check_and_cast<SwarmTelemetryApp *>(getModuleByPath(telemetryModule));
+        }
+        steerTimer = new cMessage("SteerTimer");
+        scheduleAt(simTime(), steerTimer);
+    }
+}
+
+void SwarmSteeringMobility::setInitialPosition()
+{
+    // the position is the host's at all times, see getCurrentPosition()
+    lastPosition = hostMobility->getCurrentPosition();
+}
+
+void SwarmSteeringMobility::handleSelfMessage(cMessage *msg)
+{
+    steer();
+    scheduleAfter(par("steerInterval"), steerTimer);
+}
+
+bool SwarmSteeringMobility::selectTarget(const Coord& position, Coord& target) const
+{
+    simtime_t since = simTime() - maxAge;
+    std::vector<Coord> directions;
+    std::vector<double> distances;
+    for (int id = 0; id < telemetry->getSourceTableSize(); id++) {
+        auto source = telemetry->findSource(id);
+        if (source == nullptr || source->lastReceived < since)
+            continue;
+        Coord direction = source->state.position - position;
+        double distance = direction.length();
+        if (distance > 0) {
+            directions.push_back(direction / distance);
+            distances.push_back(distance);
+        }
+    }
+    int best = -1;
+    int bestCount = 0;
+    for (int i = 0; i < (int)directions.size(); i++) {
+        int count = 0;
+        for (const auto& other : directions)
+            if (directions[i] * other >= cosHalfBeamWidth)
+                count++;
+        if (count > bestCount || (count == bestCount && distances[i] < distances[best])) {
+            best = i;
+            bestCount = count;
+        }
+    }
+    if (best == -1)
+        return false;
+    target = position + directions[best] * distances[best];
+    return true;
+}
+
+void SwarmSteeringMobility::steer()
+{
+    const Coord& position = getCurrentPosition();
+    Coord target;
+    if (targetMobility != nullptr)
+        target = targetMobility->getCurrentPosition();
+    else if (!selectTarget(position, target))
+        return;
+    Coord direction = target - position;
+    if (direction.length() == 0)
+        return;
+    lastOrientation = Quaternion::rotationFromTo(Coord::X_AXIS, direction / direction.length());
+    emitMobilityStateChangedSignal();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,52 @@
+//===================================================================================
+// SWARM STEERING MOBILITY - Boresight steering for a directional antenna
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMSTEERINGMOBILITY_H
+#define __DRONESWARM_SWARMSTEERINGMOBILITY_H
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/mobility/base/MobilityBase.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmTelemetryApp;
+
+class SwarmSteeringMobility : public MobilityBase
+{
+  protected:
+    // parameters
+    simtime_t maxAge;
+    double cosHalfBeamWidth = 0;
+
+    // context
+    ModuleRefByPar<IMobility> hostMobility;
+    ModuleRefByPar<IMobility> targetMobility;
+    SwarmTelemetryApp *telemetry = nullptr;
+    cMessage *steerTimer = nullptr;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual void setInitialPosition() override;
+    virtual void handleSelfMessage(cMessage *msg) override;
+
+    void steer();
+    bool selectTarget(const Coord& position, Coord& target) const;
+
+  public:
+    virtual ~SwarmSteeringMobility();
+
+    virtual double getMaxSpeed() const override { return hostMobility->getMaxSpeed(); }
+    virtual const Coord& getCurrentPosition() override { return lastPosition = hostMobility->getCurrentPosition(); }
+    virtual const Coord& getCurrentVelocity() override { return hostMobility->getCurrentVelocity(); }
+    virtual const Coord& getCurrentAcceleration() override { return hostMobility->getCurrentAcceleration(); }
+    virtual const Quaternion& getCurrentAngularPosition() override { return lastOrientation; }
+    virtual const Quaternion& getCurrentAngularVelocity() override { return Quaternion::IDENTITY; }
+    virtual const Quaternion& getCurrentAngularAcceleration() override { return Quaternion::IDENTITY; }
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,95 @@
+//===================================================================================
+// SWARM AIR-TO-GROUND PATH LOSS - Al-Hourani A2G model for drone <-> GCS links
+//===================================================================================
+
+#include "physical/SwarmAirToGroundPathLoss.h"
+
+#include <cmath>
+
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadioMedium.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/ISignalAnalogModel.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmAirToGroundPathLoss);
+
+void SwarmAirToGroundPathLoss::initialize(int stage)
+{
+    FreeSpacePathLoss::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        airToGround = par("airToGround");
+        groundAltitudeLimit = par("groundAltitudeLimit");
+        int tableSize = par("tableSize");
+        if (tableSize < 2)
+            throw cRuntimeError("tableSize must be at least 2");
+
+        // (a, b, η_LoS dB, η_NLoS dB), Al-Hourani et al. (2014), Table I
+        std::string environment = par("environment").stdstringValue();
+        if (environment == "suburban")
+            fillExcessLossTable(4.88, 0.43, 0.1, 21, tableSize);
+        else if (environment == "urban")
+            fillExcessLossTable(9.61, 0.16, 1.0, 20, tableSize);
+        else if (environment == "denseUrban")
+            fillExcessLossTable(12.08, 0.11, 1.6, 23, tableSize);
+        else if (environment == "highRise")
+            fillExcessLossTable(27.23, 0.08, 2.3, 34, tableSize);
+        else
+            throw cRuntimeError("Unknown environment '%s'", environment.c_str());
+    }
+}
+
+void SwarmAirToGroundPathLoss::fillExcessLossTable(double a, double b, double losExcessLoss, double nlosExcessLoss, int size)
+{
+    excessLoss.resize(size);
+    for (int i = 0; i < size; i++) {
+        double elevation = std::asin((double)i / (size - 1)) * 180 / M_PI;
+        double losProbability = 1 / (1 + a * std::exp(-b * (elevation - a)));
+        double excessLossDb = losProbability * losExcessLoss + (1 - losProbability) * nlosExcessLoss;
+        excessLoss[i] = std::pow(10, -excessLossDb / 10);
+    }
+}
+
+std::ostream& SwarmAirToGroundPathLoss::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    stream << "SwarmAirToGroundPathLoss";
+    if (level <= PRINT_LEVEL_TRACE)
+        stream << EV_FIELD(airToGround) << EV_FIELD(groundAltitudeLimit) << EV_FIELD(alpha) << EV_FIELD(systemLoss);
+    return stream;
+}
+
+double SwarmAirToGroundPathLoss::computeTwoRayPathLoss(m waveLength, m distance, double transmitterHeight, double receiverHeight) const
+{
+    double freeSpace = computeFreeSpacePathLoss(waveLength, distance, alpha, systemLoss);
+    if (transmitterHeight <= 0 || receiverHeight <= 0)
+        return freeSpace;
+    m crossover = m(4 * M_PI * transmitterHeight * receiverHeight) / waveLength.get();
+    if (distance < crossover)
+        return freeSpace;
+    double d2 = distance.get() * distance.get();
+    return transmitterHeight * transmitterHeight * receiverHeight * receiverHeight / (d2 * d2 * systemLoss);
+}
+
+double SwarmAirToGroundPathLoss::computePathLoss(const ITransmission *transmission, const IArrival *arrival) const
+{
+    auto radioMedium = transmission->getMedium();
+    auto narrowbandSignalAnalogModel = check_and_cast<const INarrowbandSignal *>(transmission->getAnalogModel());
+    mps propagationSpeed = radioMedium->getPropagation()->getPropagationSpeed();
+    m waveLength = propagationSpeed / narrowbandSignalAnalogModel->getCenterFrequency();
+    const Coord& transmitterPosition = transmission->getStartPosition();
+    const Coord& receiverPosition = arrival->getStartPosition();
+    m distance = m(transmitterPosition.distance(receiverPosition));
+    if (distance == m(0))
+        return 1;
+
+    bool transmitterOnGround = transmitterPosition.z <= groundAltitudeLimit;
+    bool receiverOnGround = receiverPosition.z <= groundAltitudeLimit;
+    if (airToGround && transmitterOnGround != receiverOnGround) {
+        double sinElevation = std::abs(transmitterPosition.z - receiverPosition.z) / distance.get();
+        int index = (int)std::lround(std::min(sinElevation, 1.0) * (excessLoss.size() - 1));
+        return computeFreeSpacePathLoss(waveLength, distance, alpha, systemLoss) * excessLoss[index];
+    }
+    return computeTwoRayPathLoss(waveLength, distance, transmitterPosition.z, receiverPosition.z);
+}
+
+} // namespace droneswarm
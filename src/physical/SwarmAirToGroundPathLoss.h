@@ -0,0 +1,36 @@
+//===================================================================================
+// SWARM AIR-TO-GROUND PATH LOSS - Al-Hourani A2G model for drone <-> GCS links
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMAIRTOGROUNDPATHLOSS_H
+#define __DRONESWARM_SWARMAIRTOGROUNDPATHLOSS_H
+
+#include <vector>
+
+#include "inet/physicallayer/wireless/common/pathloss/FreeSpacePathLoss.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmAirToGroundPathLoss : public FreeSpacePathLoss
+{
+  protected:
+    bool airToGround = true;
+    double groundAltitudeLimit = 0;
+    std::vector<double> excessLoss;     // linear factor per sin(elevation) bucket
+
+  protected:
+    virtual void initialize(int stage) override;
+    void fillExcessLossTable(double a, double b, double losExcessLoss, double nlosExcessLoss, int size);
+    double computeTwoRayPathLoss(m waveLength, m distance, double transmitterHeight, double receiverHeight) const;
+
+  public:
+    virtual std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+    virtual double computePathLoss(const ITransmission *transmission, const IArrival *arrival) const override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,74 @@
+//===================================================================================
+// SWARM CACHED SCALAR ANALOG MODEL - Per-pair attenuation reuse across frames
+//===================================================================================
+
+#include "physical/SwarmCachedScalarAnalogModel.h"
+
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmCachedScalarAnalogModel);
+
+void SwarmCachedScalarAnalogModel::initialize(int stage)
+{
+    ScalarAnalogModel::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL)
+        positionTolerance = par("positionTolerance");
+}
+
+void SwarmCachedScalarAnalogModel::finish()
+{
+    recordScalar("cacheHits", numHits);
+    recordScalar("cacheMisses", numMisses);
+}
+
+uint32_t SwarmCachedScalarAnalogModel::getEpoch(int radioId, const Coord& position, const Quaternion& orientation) const
+{
+    auto it = nodes.find(radioId);
+    if (it == nodes.end()) {
+        Node& node = nodes[radioId];
+        node.anchor = position;
+        node.orientation = orientation;
+        return 0;
+    }
+    Node& node = it->second;
+    // any turn invalidates: a steered directional antenna changes its gains
+    if (orientation != node.orientation || (positionTolerance == 0 ? position != node.anchor : position.distance(node.anchor) > positionTolerance)) {
+        node.anchor = position;
+        node.orientation = orientation;
+        node.epoch++;
+    }
+    return node.epoch;
+}
+
+W SwarmCachedScalarAnalogModel::computeReceptionPower(const IRadio *receiverRadio, const ITransmission *transmission, const IArrival *arrival) const
+{
+    auto signalAnalogModel = transmission->getAnalogModel();
+    W transmissionPower = check_and_cast<const IScalarSignal *>(signalAnalogModel)->getPower();
+    Hz centerFrequency = check_and_cast<const INarrowbandSignal *>(signalAnalogModel)->getCenterFrequency();
+    int transmitterId = transmission->getTransmitterId();
+    int receiverId = receiverRadio->getId();
+    uint32_t transmitterEpoch = getEpoch(transmitterId, transmission->getStartPosition(), transmission->getStartOrientation());
+    uint32_t receiverEpoch = getEpoch(receiverId, arrival->getStartPosition(), arrival->getStartOrientation());
+
+    Entry& entry = entries[((uint64_t)(uint32_t)transmitterId << 32) | (uint32_t)receiverId];
+    if (entry.transmitterEpoch == transmitterEpoch && entry.receiverEpoch == receiverEpoch
+            && entry.centerFrequency == centerFrequency) {
+        numHits++;
+        return transmissionPower * entry.attenuation;
+    }
+
+    numMisses++;
+    W receptionPower = ScalarAnalogModel::computeReceptionPower(receiverRadio, transmission, arrival);
+    if (transmissionPower == W(0))
+        return receptionPower;
+    entry.transmitterEpoch = transmitterEpoch;
+    entry.receiverEpoch = receiverEpoch;
+    entry.centerFrequency = centerFrequency;
+    entry.attenuation = receptionPower / transmissionPower;
+    return receptionPower;
+}
+
+} // namespace droneswarm
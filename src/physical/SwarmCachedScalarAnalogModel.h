@@ -0,0 +1,55 @@
+//===================================================================================
+// SWARM CACHED SCALAR ANALOG MODEL - Per-pair attenuation reuse across frames
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMCACHEDSCALARANALOGMODEL_H
+#define __DRONESWARM_SWARMCACHEDSCALARANALOGMODEL_H
+
+#include <unordered_map>
+
+#include "inet/physicallayer/wireless/common/analogmodel/packetlevel/ScalarAnalogModel.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmCachedScalarAnalogModel : public ScalarAnalogModel
+{
+  protected:
+    struct Node
+    {
+        Coord anchor;
+        Quaternion orientation;
+        uint32_t epoch = 0;
+    };
+
+    struct Entry
+    {
+        uint32_t transmitterEpoch = 0;
+        uint32_t receiverEpoch = 0;
+        Hz centerFrequency = Hz(NaN);
+        double attenuation = 0;
+    };
+
+    double positionTolerance = 0;
+
+    mutable std::unordered_map<int, Node> nodes;           // per radio id
+    mutable std::unordered_map<uint64_t, Entry> entries;   // per (transmitter, receiver) radio id pair
+    mutable long numHits = 0;
+    mutable long numMisses = 0;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual void finish() override;
+
+    // current epoch of a radio, bumped when it left its anchor or turned
+    uint32_t getEpoch(int radioId, const Coord& position, const Quaternion& orientation) const;
+
+  public:
+    virtual W computeReceptionPower(const IRadio *receiverRadio, const ITransmission *transmission, const IArrival *arrival) const override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,102 @@
+//===================================================================================
+// SWARM INDEXED COMMUNICATION CACHE - Interval-indexed interference lookup
+//===================================================================================
+
+#include "physical/SwarmIndexedCommunicationCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadioMedium.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/ISignalAnalogModel.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmIndexedCommunicationCache);
+
+void SwarmIndexedCommunicationCache::initialize()
+{
+    VectorCommunicationCache::initialize();
+    index.setBucketDuration(par("bucketDuration"));
+    maxPropagationDelay = par("maxPropagationDelay");
+    powerScaledRange = par("powerScaledRange");
+    medium = check_and_cast<IRadioMedium *>(getParentModule());
+}
+
+double SwarmIndexedCommunicationCache::computeInterferenceRange(const ITransmission *transmission) const
+{
+    auto signal = dynamic_cast<const IScalarSignal *>(transmission->getAnalogModel());
+    if (!powerScaledRange || signal == nullptr)
+        return INFINITY;
+    const IMediumLimitCache *limits = medium->getMediumLimitCache();
+    m maxRange = limits->getMaxInterferenceRange();
+    // maxInterferenceRange is configured for each radio at its own full power
+    W maxPower = transmission->getTransmitter()->getTransmitter()->getMaxPower();
+    W minPower = limits->getMinInterferencePower();
+    W power = signal->getPower();
+    if (std::isnan(maxRange.get()) || std::isnan(minPower.get()) || power >= maxPower)
+        return INFINITY;
+    // the configured range, shrunk by the path loss model's reach ratio
+    mps propagationSpeed = medium->getPropagation()->getPropagationSpeed();
+    Hz centerFrequency = check_and_cast<const INarrowbandSignal *>(signal)->getCenterFrequency();
+    m reach = medium->getPathLoss()->computeRange(propagationSpeed, centerFrequency, unit(minPower / power).get());
+    m fullReach = medium->getPathLoss()->computeRange(propagationSpeed, centerFrequency, unit(minPower / maxPower).get());
+    return fullReach > m(0) ? maxRange.get() * std::min(1.0, unit(reach / fullReach).get()) : INFINITY;
+}
+
+simtime_t SwarmIndexedCommunicationCache::getMaxPropagationDelay()
+{
+    if (!maxPropagationDelayChecked) {
+        // the medium's limits are only known once all radios are registered
+        m maxRange = medium->getMediumLimitCache()->getMaxInterferenceRange();
+        if (std::isnan(maxRange.get()) || std::isinf(maxRange.get())) {
+            if (maxPropagationDelay < 0)
+                throw cRuntimeError("Cannot derive maxPropagationDelay: the medium has no finite maxInterferenceRange");
+        }
+        else {
+            simtime_t required = s(maxRange / medium->getPropagation()->getPropagationSpeed()).get();
+            if (maxPropagationDelay < 0)
+                maxPropagationDelay = required;
+            else if (maxPropagationDelay < required)
+                throw cRuntimeError("maxPropagationDelay %s is shorter than the %s a signal takes over maxInterferenceRange %g m",
+                        maxPropagationDelay.ustr().c_str(), required.ustr().c_str(), maxRange.get());
+        }
+        maxPropagationDelayChecked = true;
+    }
+    return maxPropagationDelay;
+}
+
+void SwarmIndexedCommunicationCache::addTransmission(const ITransmission *transmission)
+{
+    VectorCommunicationCache::addTransmission(transmission);
+    index.add(transmission->getId(), transmission->getStartTime(), transmission->getEndTime(), {transmission, computeInterferenceRange(transmission)});
+}
+
+void SwarmIndexedCommunicationCache::removeTransmission(const ITransmission *transmission)
+{
+    index.remove(transmission->getId());
+    VectorCommunicationCache::removeTransmission(transmission);
+}
+
+void SwarmIndexedCommunicationCache::removeNonInterferingTransmissions(std::function<void (const ITransmission *transmission)> f)
+{
+    VectorCommunicationCache::removeNonInterferingTransmissions([&] (const ITransmission *transmission) {
+        index.remove(transmission->getId());    // f may delete the transmission
+        f(transmission);
+    });
+}
+
+std::vector<const ITransmission *> *SwarmIndexedCommunicationCache::computeInterferingTransmissions(const IRadio *radio, const simtime_t startTime, const simtime_t endTime)
+{
+    auto interferingTransmissions = new std::vector<const ITransmission *>();
+    index.query(startTime - getMaxPropagationDelay(), endTime, [&] (const Candidate& candidate) {
+        const ITransmission *transmission = candidate.transmission;
+        const IArrival *arrival = getCachedArrival(radio, transmission);
+        if (arrival != nullptr && !(arrival->getEndTime() < startTime || endTime < arrival->getStartTime())
+                && transmission->getStartPosition().distance(arrival->getStartPosition()) <= candidate.interferenceRange)
+            interferingTransmissions->push_back(transmission);
+    });
+    return interferingTransmissions;
+}
+
+} // namespace droneswarm
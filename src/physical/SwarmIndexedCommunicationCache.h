@@ -0,0 +1,48 @@
+//===================================================================================
+// SWARM INDEXED COMMUNICATION CACHE - Interval-indexed interference lookup
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMINDEXEDCOMMUNICATIONCACHE_H
+#define __DRONESWARM_SWARMINDEXEDCOMMUNICATIONCACHE_H
+
+#include "inet/physicallayer/wireless/common/medium/VectorCommunicationCache.h"
+#include "physical/TransmissionIndex.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmIndexedCommunicationCache : public VectorCommunicationCache
+{
+  protected:
+    struct Candidate
+    {
+        const ITransmission *transmission = nullptr;
+        double interferenceRange = INFINITY;    // m
+    };
+
+    simtime_t maxPropagationDelay = -1;     // derived at the first lookup if negative
+    bool maxPropagationDelayChecked = false;
+    bool powerScaledRange = false;
+    const IRadioMedium *medium = nullptr;
+    TransmissionIndex<Candidate> index;
+
+  protected:
+    virtual void initialize() override;
+
+    double computeInterferenceRange(const ITransmission *transmission) const;
+    simtime_t getMaxPropagationDelay();
+
+  public:
+    virtual std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override { return stream << "SwarmIndexedCommunicationCache"; }
+
+    virtual void addTransmission(const ITransmission *transmission) override;
+    virtual void removeTransmission(const ITransmission *transmission) override;
+    virtual void removeNonInterferingTransmissions(std::function<void (const ITransmission *transmission)> f) override;
+    virtual std::vector<const ITransmission *> *computeInterferingTransmissions(const IRadio *radio, const simtime_t startTime, const simtime_t endTime) override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,91 @@
+//===================================================================================
+// SWARM MIXED ANALOG MODEL - Scalar and dimensional radios on one medium
+//===================================================================================
+
+#include "physical/SwarmMixedAnalogModel.h"
+
+#include "inet/common/math/Functions.h"
+#include "inet/physicallayer/wireless/common/analogmodel/packetlevel/DimensionalReception.h"
+#include "inet/physicallayer/wireless/common/analogmodel/packetlevel/ScalarReception.h"
+#include "inet/physicallayer/wireless/common/base/packetlevel/DimensionalTransmitterBase.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+
+namespace droneswarm {
+
+using namespace inet::math;
+
+Define_Module(SwarmMixedAnalogModel);
+
+void SwarmMixedAnalogModel::initialize()
+{
+    scalarModel = check_and_cast<ScalarAnalogModel *>(getSubmodule("scalar"));
+    dimensionalModel = check_and_cast<DimensionalAnalogModel *>(getSubmodule("dimensional"));
+}
+
+bool SwarmMixedAnalogModel::isDimensional(const IRadio *radio)
+{
+    return dynamic_cast<const DimensionalTransmitterBase *>(radio->getTransmitter()) != nullptr;
+}
+
+std::ostream& SwarmMixedAnalogModel::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    return stream << "SwarmMixedAnalogModel";
+}
+
+const IReception *SwarmMixedAnalogModel::computeReception(const IRadio *receiverRadio, const ITransmission *transmission, const IArrival *arrival) const
+{
+    bool dimensionalTransmission = dynamic_cast<const IDimensionalSignal *>(transmission->getAnalogModel()) != nullptr;
+    bool dimensionalReceiver = isDimensional(receiverRadio);
+    if (dimensionalTransmission == dimensionalReceiver)
+        return dimensionalReceiver ? dimensionalModel->computeReception(receiverRadio, transmission, arrival)
+                                   : scalarModel->computeReception(receiverRadio, transmission, arrival);
+
+    auto narrowbandSignalAnalogModel = check_and_cast<const INarrowbandSignal *>(transmission->getAnalogModel());
+    Hz centerFrequency = narrowbandSignalAnalogModel->getCenterFrequency();
+    Hz bandwidth = narrowbandSignalAnalogModel->getBandwidth();
+    simtime_t startTime = arrival->getStartTime();
+    simtime_t endTime = arrival->getEndTime();
+    if (dimensionalTransmission) {
+        // scalar receiver: the weakest in-band power over the frame, as a
+        // scalar receiver would have to decode through it
+        auto reception = check_and_cast<const DimensionalReception *>(dimensionalModel->computeReception(receiverRadio, transmission, arrival));
+        W power = reception->computeMinPower(startTime, endTime);
+        delete reception;
+        return new ScalarReception(receiverRadio, transmission, startTime, endTime,
+                arrival->getStartPosition(), arrival->getEndPosition(), arrival->getStartOrientation(), arrival->getEndOrientation(),
+                centerFrequency, bandwidth, power);
+    }
+    else {
+        // dimensional receiver: the scalar received power as a flat block
+        W power = scalarModel->computeReceptionPower(receiverRadio, transmission, arrival);
+        Ptr<const IFunction<WpHz, Domain<simsec, Hz>>> powerFunction = makeShared<Boxcar2DFunction<WpHz, simsec, Hz>>(
+                simsec(startTime), simsec(endTime), centerFrequency - bandwidth / 2, centerFrequency + bandwidth / 2, power / bandwidth);
+        return new DimensionalReception(receiverRadio, transmission, startTime, endTime,
+                arrival->getStartPosition(), arrival->getEndPosition(), arrival->getStartOrientation(), arrival->getEndOrientation(),
+                centerFrequency, bandwidth, powerFunction);
+    }
+}
+
+const INoise *SwarmMixedAnalogModel::computeNoise(const IListening *listening, const IInterference *interference) const
+{
+    // all interfering receptions were computed for this receiver, so they share its representation
+    if (isDimensional(listening->getReceiver()))
+        return dimensionalModel->computeNoise(listening, interference);
+    return scalarModel->computeNoise(listening, interference);
+}
+
+const INoise *SwarmMixedAnalogModel::computeNoise(const IReception *reception, const INoise *noise) const
+{
+    if (dynamic_cast<const DimensionalReception *>(reception))
+        return dimensionalModel->computeNoise(reception, noise);
+    return scalarModel->computeNoise(reception, noise);
+}
+
+const ISnir *SwarmMixedAnalogModel::computeSNIR(const IReception *reception, const INoise *noise) const
+{
+    if (dynamic_cast<const DimensionalReception *>(reception))
+        return dimensionalModel->computeSNIR(reception, noise);
+    return scalarModel->computeSNIR(reception, noise);
+}
+
+} // namespace droneswarm
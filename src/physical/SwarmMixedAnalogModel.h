@@ -0,0 +1,38 @@
+//===================================================================================
+// SWARM MIXED ANALOG MODEL - Scalar and dimensional radios on one medium
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMMIXEDANALOGMODEL_H
+#define __DRONESWARM_SWARMMIXEDANALOGMODEL_H
+
+#include "inet/physicallayer/wireless/common/analogmodel/packetlevel/DimensionalAnalogModel.h"
+#include "inet/physicallayer/wireless/common/analogmodel/packetlevel/ScalarAnalogModel.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmMixedAnalogModel : public cModule, public IAnalogModel
+{
+  protected:
+    ScalarAnalogModel *scalarModel = nullptr;
+    DimensionalAnalogModel *dimensionalModel = nullptr;
+
+  protected:
+    virtual void initialize() override;
+
+  public:
+    // a radio is dimensional if its transmitter produces dimensional signals
+    static bool isDimensional(const IRadio *radio);
+
+    virtual std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+    virtual const IReception *computeReception(const IRadio *receiverRadio, const ITransmission *transmission, const IArrival *arrival) const override;
+    virtual const INoise *computeNoise(const IListening *listening, const IInterference *interference) const override;
+    virtual const INoise *computeNoise(const IReception *reception, const INoise *noise) const override;
+    virtual const ISnir *computeSNIR(const IReception *reception, const INoise *noise) const override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,31 @@
+//===================================================================================
+// SWARM MIXED BACKGROUND NOISE - Isotropic noise for scalar and dimensional radios
+//===================================================================================
+
+#include "physical/SwarmMixedBackgroundNoise.h"
+
+#include "physical/SwarmMixedAnalogModel.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmMixedBackgroundNoise);
+
+void SwarmMixedBackgroundNoise::initialize()
+{
+    scalarNoise = check_and_cast<IBackgroundNoise *>(getSubmodule("scalar"));
+    dimensionalNoise = check_and_cast<IBackgroundNoise *>(getSubmodule("dimensional"));
+}
+
+std::ostream& SwarmMixedBackgroundNoise::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    return stream << "SwarmMixedBackgroundNoise";
+}
+
+const INoise *SwarmMixedBackgroundNoise::computeNoise(const IListening *listening) const
+{
+    if (SwarmMixedAnalogModel::isDimensional(listening->getReceiver()))
+        return dimensionalNoise->computeNoise(listening);
+    return scalarNoise->computeNoise(listening);
+}
+
+} // namespace droneswarm
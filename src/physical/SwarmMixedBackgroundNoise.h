@@ -0,0 +1,31 @@
+//===================================================================================
+// SWARM MIXED BACKGROUND NOISE - Isotropic noise for scalar and dimensional radios
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMMIXEDBACKGROUNDNOISE_H
+#define __DRONESWARM_SWARMMIXEDBACKGROUNDNOISE_H
+
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IBackgroundNoise.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmMixedBackgroundNoise : public cModule, public IBackgroundNoise
+{
+  protected:
+    IBackgroundNoise *scalarNoise = nullptr;
+    IBackgroundNoise *dimensionalNoise = nullptr;
+
+  protected:
+    virtual void initialize() override;
+
+  public:
+    virtual std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+    virtual const INoise *computeNoise(const IListening *listening) const override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,60 @@
+//===================================================================================
+// SWARM PATTERN ANTENNA - Directional antenna with a precomputed gain table
+//===================================================================================
+
+#include "physical/SwarmPatternAntenna.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace droneswarm {
+
+Define_Module(SwarmPatternAntenna);
+
+void SwarmPatternAntenna::AntennaGain::fill(double maxGainDb, double minGainDb, double beamWidth)
+{
+    if (minGainDb > maxGainDb)
+        throw cRuntimeError("minGain must not exceed maxGain");
+    maxGain = math::dB2fraction(maxGainDb);
+    minGain = math::dB2fraction(minGainDb);
+    int size = (int)std::round(180 / TABLE_STEP) + 1;
+    gains.resize(size);
+    for (int i = 0; i < size; i++) {
+        double angle = i * TABLE_STEP;
+        gains[i] = math::dB2fraction(std::max(maxGainDb - 12 * (angle / beamWidth) * (angle / beamWidth), minGainDb));
+    }
+}
+
+double SwarmPatternAntenna::AntennaGain::computeGain(const Quaternion& direction) const
+{
+    double cosAngle = direction.rotate(Coord::X_AXIS).x;
+    double angle = std::acos(std::min(std::max(cosAngle, -1.0), 1.0)) * 180 / M_PI;
+    return gains[(int)std::lround(angle / TABLE_STEP)];
+}
+
+SwarmPatternAntenna::SwarmPatternAntenna() :
+    gain(makeShared<AntennaGain>())
+{
+}
+
+void SwarmPatternAntenna::initialize(int stage)
+{
+    AntennaBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        double beamWidth = par("beamWidth");
+        if (beamWidth <= 0)
+            throw cRuntimeError("beamWidth must be positive");
+        gain->fill(par("maxGain"), par("minGain"), beamWidth);
+    }
+}
+
+std::ostream& SwarmPatternAntenna::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    stream << "SwarmPatternAntenna";
+    if (level <= PRINT_LEVEL_DETAIL)
+        stream << EV_FIELD(maxGain, gain->getMaxGain()) << EV_FIELD(minGain, gain->getMinGain());
+    return AntennaBase::printToStream(stream, level, evFlags);
+}
+
+} // namespace droneswarm
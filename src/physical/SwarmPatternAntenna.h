@@ -0,0 +1,50 @@
+//===================================================================================
+// SWARM PATTERN ANTENNA - Directional antenna with a precomputed gain table
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMPATTERNANTENNA_H
+#define __DRONESWARM_SWARMPATTERNANTENNA_H
+
+#include <vector>
+
+#include "inet/physicallayer/wireless/common/base/packetlevel/AntennaBase.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmPatternAntenna : public AntennaBase
+{
+  protected:
+    class AntennaGain : public IAntennaGain
+    {
+      protected:
+        double minGain = 1;
+        double maxGain = 1;
+        std::vector<double> gains;      // linear, per TABLE_STEP of off-boresight angle
+
+      public:
+        static constexpr double TABLE_STEP = 0.5;   // deg
+
+        void fill(double maxGainDb, double minGainDb, double beamWidth);
+        virtual double getMinGain() const override { return minGain; }
+        virtual double getMaxGain() const override { return maxGain; }
+        virtual double computeGain(const Quaternion& direction) const override;
+    };
+
+    Ptr<AntennaGain> gain;
+
+  protected:
+    virtual void initialize(int stage) override;
+
+  public:
+    SwarmPatternAntenna();
+
+    virtual std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+    virtual Ptr<const IAntennaGain> getGain() const override { return gain; }
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,130 @@
+//===================================================================================
+// SWARM POWER CONTROL - Transmit power from the distance to needed neighbors
+//===================================================================================
+
+#include "physical/SwarmPowerControl.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "inet/physicallayer/wireless/common/base/packetlevel/NarrowbandTransmitterBase.h"
+
+#include "telemetry/SwarmTelemetryApp.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmPowerControl);
+
+simsignal_t SwarmPowerControl::transmitPowerSignal = cComponent::registerSignal("transmitPower");
+simsignal_t SwarmPowerControl::communicationRangeSignal = cComponent::registerSignal("communicationRange");
+simsignal_t SwarmPowerControl::spatialReuseSignal = cComponent::registerSignal("spatialReuse");
+
+SwarmPowerControl::~SwarmPowerControl()
+{
+    cancelAndDelete(updateTimer);
+}
+
+void SwarmPowerControl::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        maxAge = par("maxAge");
+        numNeighbors = par("numNeighbors");
+        if (numNeighbors < 1)
+            throw cRuntimeError("numNeighbors must be at least 1, got %d", numNeighbors);
+        margin = math::dB2fraction(par("margin"));
+        minPower = W(par("minPower"));
+        telemetry = check_and_cast<SwarmTelemetryApp *>(getModuleByPath(par("telemetryModule")));
+        cModule *radioModule = getModuleByPath(par("radioModule"));
+        radio = check_and_cast<IRadio *>(radioModule);
+        radioModule->subscribe(IRadio::transmissionStateChangedSignal, this);
+        radioMedium.reference(this, "radioMediumModule", true);
+        mobility.reference(this, "mobilityModule", true);
+        anchor.reference(this, "anchorModule", false);
+        updateTimer = new cMessage("PowerControlUpdate");
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // the transmitter's configured power is the ceiling
+        maxPower = radio->getTransmitter()->getMaxPower();
+        power = maxPower;
+        scheduleAt(simTime(), updateTimer);
+    }
+}
+
+void SwarmPowerControl::handleMessage(cMessage *msg)
+{
+    if (msg != updateTimer)
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+    update();
+    scheduleAfter(par("updateInterval"), updateTimer);
+}
+
+void SwarmPowerControl::update()
+{
+    const Coord& position = mobility->getCurrentPosition();
+    simtime_t since = simTime() - maxAge;
+    std::vector<double> distances;
+    for (int id = 0; id < telemetry->getSourceTableSize(); id++) {
+        auto source = telemetry->findSource(id);
+        if (source != nullptr && source->lastHeardDirect >= since && id != (int)telemetry->getNodeId())
+            distances.push_back(position.distance(source->state.position));
+    }
+    std::sort(distances.begin(), distances.end());
+    double required = 0;
+    if (!distances.empty())
+        required = distances[std::min(numNeighbors, (int)distances.size()) - 1];
+    if (anchor != nullptr) {
+        double distance = position.distance(anchor->getCurrentPosition());
+        if (distance <= computeRange(maxPower).get())
+            required = std::max(required, distance);
+    }
+
+    if (required == 0)
+        power = maxPower;       // nobody heard and no anchor in reach: stay discoverable
+    else {
+        const IRadioMedium *medium = radioMedium.get();
+        double loss = medium->getPathLoss()->computePathLoss(medium->getPropagation()->getPropagationSpeed(), getCenterFrequency(), m(required));
+        W minReceptionPower = radio->getReceiver()->getMinReceptionPower();
+        power = std::max(minPower, std::min(maxPower, minReceptionPower / loss * margin));
+    }
+
+    double range = computeRange(power).get();
+    double fullRange = computeRange(maxPower).get();
+    EV_DEBUG << "Transmit power " << power << " for " << required << " m, range " << range << " m" << endl;
+    emit(transmitPowerSignal, mW(power).get());
+    emit(communicationRangeSignal, range);
+    emit(spatialReuseSignal, range > 0 ? (fullRange / range) * (fullRange / range) : 1.0);
+}
+
+m SwarmPowerControl::computeRange(W transmitPower) const
+{
+    const IRadioMedium *medium = radioMedium.get();
+    double loss = unit(radio->getReceiver()->getMinReceptionPower() / transmitPower).get();
+    return medium->getPathLoss()->computeRange(medium->getPropagation()->getPropagationSpeed(), getCenterFrequency(), loss);
+}
+
+Hz SwarmPowerControl::getCenterFrequency() const
+{
+    // read on every use: SwarmChannelPlanner may retune the radio
+    return check_and_cast<const NarrowbandTransmitterBase *>(radio->getTransmitter())->getCenterFrequency();
+}
+
+void SwarmPowerControl::receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details)
+{
+    if (signalID != IRadio::transmissionStateChangedSignal)
+        return;
+    if (value == IRadio::TRANSMISSION_STATE_TRANSMITTING) {
+        transmissionStart = simTime();
+        framePower = power;
+    }
+    else if (transmissionStart != -1) {
+        energySaved += (maxPower - framePower) * s((simTime() - transmissionStart).dbl());
+        transmissionStart = -1;
+    }
+}
+
+void SwarmPowerControl::finish()
+{
+    recordScalar("energySaved", energySaved.get(), "J");
+}
+
+} // namespace droneswarm
@@ -0,0 +1,68 @@
+//===================================================================================
+// SWARM POWER CONTROL - Transmit power from the distance to needed neighbors
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMPOWERCONTROL_H
+#define __DRONESWARM_SWARMPOWERCONTROL_H
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadioMedium.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmTelemetryApp;
+
+class SwarmPowerControl : public cSimpleModule, public cListener
+{
+  protected:
+    // parameters
+    simtime_t maxAge;
+    int numNeighbors = 0;
+    double margin = 1;
+    W minPower = W(0);
+
+    // context
+    SwarmTelemetryApp *telemetry = nullptr;
+    IRadio *radio = nullptr;
+    ModuleRefByPar<IRadioMedium> radioMedium;
+    ModuleRefByPar<IMobility> mobility;
+    ModuleRefByPar<IMobility> anchor;
+    cMessage *updateTimer = nullptr;
+
+    // state
+    W maxPower = W(0);
+    W power = W(0);
+    W framePower = W(0);                // power of the frame on the air
+    simtime_t transmissionStart = -1;
+    J energySaved = J(0);
+
+    static simsignal_t transmitPowerSignal;
+    static simsignal_t communicationRangeSignal;
+    static simsignal_t spatialReuseSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details) override;
+
+    void update();
+    m computeRange(W transmitPower) const;
+    Hz getCenterFrequency() const;
+
+  public:
+    virtual ~SwarmPowerControl();
+
+    W getTransmitPower() const { return power; }
+};
+
+} // namespace droneswarm
+
+#endif
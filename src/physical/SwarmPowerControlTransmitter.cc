@@ -0,0 +1,29 @@
+//===================================================================================
+// SWARM POWER CONTROL TRANSMITTER - 802.11 transmitter with controlled power
+//===================================================================================
+
+#include "physical/SwarmPowerControlTransmitter.h"
+
+#include "inet/physicallayer/wireless/common/contract/packetlevel/SignalTag_m.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmPowerControlTransmitter);
+
+void SwarmPowerControlTransmitter::initialize(int stage)
+{
+    Ieee80211ScalarTransmitter::initialize(stage);
+    if (stage == INITSTAGE_LOCAL)
+        powerControl.reference(this, "powerControlModule", true);
+}
+
+const ITransmission *SwarmPowerControlTransmitter::createTransmission(const IRadio *radio, const Packet *packet, simtime_t startTime) const
+{
+    // computeTransmissionPower() honors SignalPowerReq
+    auto mutablePacket = const_cast<Packet *>(packet);
+    if (mutablePacket->findTag<SignalPowerReq>() == nullptr)
+        mutablePacket->addTag<SignalPowerReq>()->setPower(powerControl->getTransmitPower());
+    return Ieee80211ScalarTransmitter::createTransmission(radio, packet, startTime);
+}
+
+} // namespace droneswarm
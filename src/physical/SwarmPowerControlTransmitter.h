@@ -0,0 +1,32 @@
+//===================================================================================
+// SWARM POWER CONTROL TRANSMITTER - 802.11 transmitter with controlled power
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMPOWERCONTROLTRANSMITTER_H
+#define __DRONESWARM_SWARMPOWERCONTROLTRANSMITTER_H
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/physicallayer/wireless/ieee80211/packetlevel/Ieee80211ScalarTransmitter.h"
+
+#include "physical/SwarmPowerControl.h"
+
+namespace droneswarm {
+
+using namespace inet;
+using namespace inet::physicallayer;
+
+class SwarmPowerControlTransmitter : public Ieee80211ScalarTransmitter
+{
+  protected:
+    ModuleRefByPar<SwarmPowerControl> powerControl;
+
+  protected:
+    virtual void initialize(int stage) override;
+
+  public:
+    virtual const ITransmission *createTransmission(const IRadio *radio, const Packet *packet, simtime_t startTime) const override;
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,119 @@
+//===================================================================================
+// TRANSMISSION INDEX - Time-bucketed interval index of ongoing transmissions
+//===================================================================================
+// Each transmission is entered into every fixed-width time bucket its
+// [start, end] interval touches (one or two for 802.11 frames with 1 ms
+// buckets). An overlap query visits only the buckets of its window and
+// reports every live interval once, from the first bucket of the window it
+// appears in, so a query costs O(buckets + k) instead of a scan of all
+// transmissions in the medium.
+//
+// Removal only drops the value and the live counts of its buckets; leading
+// buckets are popped once nothing in them is live. Transmissions end in
+// roughly start order, so removal and purging are amortized O(1).
+//===================================================================================
+
+#ifndef __DRONESWARM_TRANSMISSIONINDEX_H
+#define __DRONESWARM_TRANSMISSIONINDEX_H
+
+#include <cmath>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+
+namespace droneswarm {
+
+template <typename T>
+class TransmissionIndex
+{
+  protected:
+    struct Interval
+    {
+        omnetpp::simtime_t start;
+        omnetpp::simtime_t end;
+        T value;
+    };
+
+    struct Bucket
+    {
+        std::vector<int> ids;       // in insertion order, removed ones included
+        int numLive = 0;
+    };
+
+    omnetpp::simtime_t bucketDuration;
+    std::deque<Bucket> buckets;
+    long firstBucket = 0;
+    std::unordered_map<int, Interval> live;
+
+    long getBucket(omnetpp::simtime_t time) const { return (long)std::floor(time / bucketDuration); }
+
+  public:
+    explicit TransmissionIndex(omnetpp::simtime_t bucketDuration = 0.001) : bucketDuration(bucketDuration) {}
+
+    void setBucketDuration(omnetpp::simtime_t duration) { bucketDuration = duration; }
+    int getNumLive() const { return live.size(); }
+    int getNumBuckets() const { return buckets.size(); }
+
+    void add(int id, omnetpp::simtime_t start, omnetpp::simtime_t end, const T& value)
+    {
+        long first = getBucket(start);
+        long last = getBucket(end);
+        if (buckets.empty())
+            firstBucket = first;
+        for (; firstBucket > first; firstBucket--)
+            buckets.emplace_front();
+        while (firstBucket + (long)buckets.size() <= last)
+            buckets.emplace_back();
+        for (long b = first; b <= last; b++) {
+            Bucket& bucket = buckets[b - firstBucket];
+            bucket.ids.push_back(id);
+            bucket.numLive++;
+        }
+        live[id] = {start, end, value};
+    }
+
+    void remove(int id)
+    {
+        auto it = live.find(id);
+        if (it == live.end())
+            return;
+        long first = std::max(getBucket(it->second.start), firstBucket);
+        long last = std::min(getBucket(it->second.end), firstBucket + (long)buckets.size() - 1);
+        for (long b = first; b <= last; b++)
+            buckets[b - firstBucket].numLive--;
+        live.erase(it);
+        while (!buckets.empty() && buckets.front().numLive == 0) {
+            buckets.pop_front();
+            firstBucket++;
+        }
+    }
+
+    // calls f(value) for every live interval that overlaps [from, to], in insertion order per start bucket
+    template <typename F>
+    void query(omnetpp::simtime_t from, omnetpp::simtime_t to, F f) const
+    {
+        if (buckets.empty())
+            return;
+        long first = std::max(getBucket(from), firstBucket);
+        long last = std::min(getBucket(to), firstBucket + (long)buckets.size() - 1);
+        for (long b = first; b <= last; b++) {
+            for (int id : buckets[b - firstBucket].ids) {
+                auto it = live.find(id);
+                if (it == live.end())
+                    continue;
+                const Interval& interval = it->second;
+                if (std::max(getBucket(interval.start), first) != b)
+                    continue;   // reported from an earlier bucket
+                if (interval.end < from || to < interval.start)
+                    continue;
+                f(interval.value);
+            }
+        }
+    }
+};
+
+} // namespace droneswarm
+
+#endif
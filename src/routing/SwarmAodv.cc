@@ -0,0 +1,75 @@
+//===================================================================================
+// SWARM AODV - AODV with telemetry as implicit HELLOs
+//===================================================================================
+
+#include "routing/SwarmAodv.h"
+
+#include "inet/networklayer/common/IpProtocolId_m.h"
+#include "inet/routing/aodv/AodvRouteData.h"
+#include "inet/transportlayer/udp/UdpHeader_m.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmAodv);
+
+simsignal_t SwarmAodv::implicitHelloSignal = cComponent::registerSignal("implicitHello");
+simsignal_t SwarmAodv::helloSuppressedSignal = cComponent::registerSignal("helloSuppressed");
+
+void SwarmAodv::initialize(int stage)
+{
+    Aodv::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL)
+        telemetryPort = par("telemetryPort");
+}
+
+bool SwarmAodv::isTelemetryDatagram(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header) const
+{
+    if (!ipv4Header->getDestAddress().isMulticast() || ipv4Header->getProtocolId() != IP_PROT_UDP || ipv4Header->getFragmentOffset() != 0)
+        return false;
+    const auto& udpHeader = datagram->peekAt<UdpHeader>(ipv4Header->getChunkLength());
+    return udpHeader->getDestinationPort() == telemetryPort;
+}
+
+void SwarmAodv::refreshNeighbor(const L3Address& neighbor)
+{
+    // same as receiving a HELLO (RFC 3561 sec. 6.9): make sure there is an
+    // active route to the neighbor, living at least ALLOWED_HELLO_LOSS * HELLO_INTERVAL
+    simtime_t lifeTime = simTime() + allowedHelloLoss * helloInterval;
+    IRoute *route = routingTable->findBestMatchingRoute(neighbor);
+    if (route == nullptr || route->getSource() != this)
+        createRoute(neighbor, neighbor, 1, false, 0, true, lifeTime);
+    else {
+        auto routeData = check_and_cast<AodvRouteData *>(route->getProtocolData());
+        updateRoutingTable(route, neighbor, 1, routeData->hasValidDestNum(), routeData->getDestSeqNum(), true,
+                std::max(routeData->getLifeTime(), lifeTime));
+    }
+    emit(implicitHelloSignal, 1L);
+}
+
+INetfilter::IHook::Result SwarmAodv::datagramPreRoutingHook(Packet *datagram)
+{
+    Enter_Method("datagramPreRoutingHook");
+    if (isUp() && useHelloMessages) {
+        // 224.0.0.1 is never forwarded, so the source is always a one-hop neighbor
+        const auto& ipv4Header = datagram->peekAtFront<Ipv4Header>();
+        L3Address source = ipv4Header->getSrcAddress();
+        if (isTelemetryDatagram(datagram, ipv4Header) && !interfaceTable->isLocalAddress(source))
+            refreshNeighbor(source);
+    }
+    return Aodv::datagramPreRoutingHook(datagram);
+}
+
+INetfilter::IHook::Result SwarmAodv::datagramLocalOutHook(Packet *datagram)
+{
+    Enter_Method("datagramLocalOutHook");
+    if (isUp() && useHelloMessages && isTelemetryDatagram(datagram, datagram->peekAtFront<Ipv4Header>())) {
+        // a HELLO would have been due in this interval
+        if (lastBroadcastTime == 0 || simTime() - lastBroadcastTime > helloInterval)
+            emit(helloSuppressedSignal, 1L);
+        lastBroadcastTime = simTime();
+    }
+    return Aodv::datagramLocalOutHook(datagram);
+}
+
+} // namespace droneswarm
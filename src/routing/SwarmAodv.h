@@ -0,0 +1,37 @@
+//===================================================================================
+// SWARM AODV - AODV with telemetry as implicit HELLOs
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMAODV_H
+#define __DRONESWARM_SWARMAODV_H
+
+#include "inet/networklayer/ipv4/Ipv4Header_m.h"
+#include "inet/routing/aodv/Aodv.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmAodv : public aodv::Aodv
+{
+  protected:
+    int telemetryPort = -1;
+
+    static simsignal_t implicitHelloSignal;
+    static simsignal_t helloSuppressedSignal;
+
+  protected:
+    virtual void initialize(int stage) override;
+
+    bool isTelemetryDatagram(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header) const;
+    void refreshNeighbor(const L3Address& neighbor);
+
+  public:
+    // netfilter
+    virtual Result datagramPreRoutingHook(Packet *datagram) override;
+    virtual Result datagramLocalOutHook(Packet *datagram) override;
+};
+
+} // namespace droneswarm
+
+#endif
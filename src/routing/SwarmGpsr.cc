@@ -0,0 +1,470 @@
+//===================================================================================
+// SWARM GPSR - Greedy Perimeter Stateless Routing for the FANET
+//===================================================================================
+
+#include "routing/SwarmGpsr.h"
+
+#include <cmath>
+#include <limits>
+
+#include "inet/common/ModuleAccess.h"
+#include "inet/linklayer/common/InterfaceTag_m.h"
+#include "inet/networklayer/common/IpProtocolId_m.h"
+#include "inet/networklayer/common/NextHopAddressTag_m.h"
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+#include "inet/transportlayer/udp/UdpHeader_m.h"
+
+#include "routing/SwarmIpv4Options.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmGpsr);
+
+std::unordered_map<uint32_t, Coord> SwarmGpsr::stationaryRegistry;
+
+simsignal_t SwarmGpsr::beaconSentSignal = cComponent::registerSignal("beaconSent");
+simsignal_t SwarmGpsr::beaconSuppressedSignal = cComponent::registerSignal("beaconSuppressed");
+simsignal_t SwarmGpsr::greedyForwardedSignal = cComponent::registerSignal("greedyForwarded");
+simsignal_t SwarmGpsr::perimeterForwardedSignal = cComponent::registerSignal("perimeterForwarded");
+simsignal_t SwarmGpsr::droppedNoRouteSignal = cComponent::registerSignal("droppedNoRoute");
+simsignal_t SwarmGpsr::neighborCountSignal = cComponent::registerSignal("neighborCount");
+
+// Perimeter mode works on the horizontal plane: altitude spread (50-120 m) is
+// small compared to radio range, and planarization needs a 2D graph.
+static Coord flat(const Coord& c)
+{
+    return Coord(c.x, c.y, 0);
+}
+
+static double cross(const Coord& o, const Coord& a, const Coord& b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// proper intersection of segments p1-p2 and q1-q2 in the x-y plane
+static bool segmentsIntersect(const Coord& p1, const Coord& p2, const Coord& q1, const Coord& q2)
+{
+    double d1 = cross(q1, q2, p1);
+    double d2 = cross(q1, q2, p2);
+    double d3 = cross(p1, p2, q1);
+    double d4 = cross(p1, p2, q2);
+    return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0));
+}
+
+SwarmGpsr::~SwarmGpsr()
+{
+    cancelAndDelete(beaconTimer);
+    cancelAndDelete(purgeTimer);
+}
+
+void SwarmGpsr::initialize(int stage)
+{
+    RoutingProtocolBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        telemetryPort = par("telemetryPort");
+        beaconPort = par("beaconPort");
+        beaconInterval = par("beaconInterval");
+        maxJitter = par("maxJitter");
+        neighborValidityInterval = par("neighborValidityInterval");
+        stationary = par("stationary");
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        routingTable.reference(this, "routingTableModule", true);
+        networkProtocol.reference(this, "networkProtocolModule", true);
+        mobility = check_and_cast<IMobility *>(getContainingNode(this)->getSubmodule("mobility"));
+        beaconTimer = new cMessage("BeaconTimer");
+        purgeTimer = new cMessage("PurgeTimer");
+    }
+    else if (stage == INITSTAGE_ROUTING_PROTOCOLS) {
+        networkProtocol->registerHook(0, this);
+    }
+}
+
+void SwarmGpsr::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg == beaconTimer)
+        processBeaconTimer();
+    else if (msg == purgeTimer)
+        processPurgeTimer();
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmGpsr::finish()
+{
+    if (stationary)
+        stationaryRegistry.erase(selfAddress.getInt());
+}
+
+//-----------------------------------------------------------------------------------
+// Beacons and position learning
+//-----------------------------------------------------------------------------------
+
+void SwarmGpsr::processBeaconTimer()
+{
+    // a telemetry multicast sent within the last interval already told every
+    // neighbor where we are, so the explicit beacon is redundant
+    if (lastTelemetrySent > SIMTIME_ZERO && simTime() - lastTelemetrySent < beaconInterval)
+        emit(beaconSuppressedSignal, 1L);
+    else {
+        auto beacon = makeShared<SwarmGpsrBeacon>();
+        beacon->setAddress(selfAddress);
+        beacon->setPosition(getSelfPosition());
+        auto packet = new Packet("SwarmGpsrBeacon", beacon);
+        packet->addTag<InterfaceReq>()->setInterfaceId(outputInterfaceId);
+        socket.sendTo(packet, Ipv4Address::ALLONES_ADDRESS, beaconPort);
+        emit(beaconSentSignal, 1L);
+    }
+    scheduleAfter(beaconInterval + uniform(-1, 1) * maxJitter, beaconTimer);
+}
+
+void SwarmGpsr::processPurgeTimer()
+{
+    simtime_t expiry = simTime() - neighborValidityInterval;
+    for (auto table : { &neighbors, &locations }) {
+        for (auto it = table->begin(); it != table->end();) {
+            if (it->second.lastSeen < expiry)
+                it = table->erase(it);
+            else
+                ++it;
+        }
+    }
+    emit(neighborCountSignal, (long)neighbors.size());
+    scheduleAfter(neighborValidityInterval / 2, purgeTimer);
+}
+
+void SwarmGpsr::updateNeighbor(const Ipv4Address& address, const Coord& position)
+{
+    auto& entry = neighbors[address.getInt()];
+    entry.position = position;
+    entry.lastSeen = simTime();
+}
+
+void SwarmGpsr::updateLocation(const Ipv4Address& address, const Coord& position)
+{
+    auto& entry = locations[address.getInt()];
+    entry.position = position;
+    entry.lastSeen = simTime();
+}
+
+Coord SwarmGpsr::getSelfPosition() const
+{
+    return mobility->getCurrentPosition();
+}
+
+bool SwarmGpsr::lookupDestinationPosition(const Ipv4Address& destination, Coord& position) const
+{
+    for (auto table : { &neighbors, &locations }) {
+        auto it = table->find(destination.getInt());
+        if (it != table->end()) {
+            position = it->second.position;
+            return true;
+        }
+    }
+    auto jt = stationaryRegistry.find(destination.getInt());
+    if (jt != stationaryRegistry.end()) {
+        position = jt->second;
+        return true;
+    }
+    return false;
+}
+
+void SwarmGpsr::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    const auto& beacon = packet->peekAtFront<SwarmGpsrBeacon>();
+    Ipv4Address address = beacon->getAddress().toIpv4();
+    if (address != selfAddress) {
+        updateNeighbor(address, beacon->getPosition());
+        updateLocation(address, beacon->getPosition());
+    }
+    delete packet;
+}
+
+void SwarmGpsr::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+//-----------------------------------------------------------------------------------
+// Telemetry piggybacking
+//-----------------------------------------------------------------------------------
+
+bool SwarmGpsr::isTelemetryDatagram(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header) const
+{
+    if (ipv4Header->getProtocolId() != IP_PROT_UDP || ipv4Header->getFragmentOffset() != 0)
+        return false;
+    const auto& udpHeader = datagram->peekAt<UdpHeader>(ipv4Header->getChunkLength());
+    return udpHeader->getDestinationPort() == telemetryPort;
+}
+
+void SwarmGpsr::attachPositionOption(Packet *datagram)
+{
+    const auto& ipv4Header = datagram->peekAtFront<Ipv4Header>();
+    auto option = new SwarmPositionOption();
+    option->setPosition(getSelfPosition());
+    option->setInitialTtl(ipv4Header->getTimeToLive());
+    insertIpv4Option(datagram, option);
+}
+
+void SwarmGpsr::learnFromTelemetry(const Ptr<const Ipv4Header>& ipv4Header)
+{
+    auto option = check_and_cast<const SwarmPositionOption *>(ipv4Header->findOptionByType(IPOPTION_TLV_SWARM_POSITION));
+    Ipv4Address source = ipv4Header->getSrcAddress();
+    if (source == selfAddress)
+        return;
+    updateLocation(source, option->getPosition());
+    // an unchanged TTL means the originator itself transmitted this copy
+    if (ipv4Header->getTimeToLive() == option->getInitialTtl())
+        updateNeighbor(source, option->getPosition());
+}
+
+//-----------------------------------------------------------------------------------
+// Forwarding
+//-----------------------------------------------------------------------------------
+
+SwarmGpsrOption *SwarmGpsr::getGpsrOptionForUpdate(Packet *datagram)
+{
+    return findMutableIpv4Option<SwarmGpsrOption>(datagram, IPOPTION_TLV_SWARM_GPSR);
+}
+
+void SwarmGpsr::attachGpsrOption(Packet *datagram, SwarmGpsrOption *option)
+{
+    insertIpv4Option(datagram, option);
+}
+
+INetfilter::IHook::Result SwarmGpsr::routeDatagram(Packet *datagram, const Ipv4Address& destination)
+{
+    SwarmGpsrOption *option = getGpsrOptionForUpdate(datagram);
+    if (option == nullptr) {
+        Coord destinationPosition;
+        if (!lookupDestinationPosition(destination, destinationPosition)) {
+            EV_WARN << "No position known for " << destination << ", dropping " << datagram->getName() << endl;
+            emit(droppedNoRouteSignal, 1L);
+            return DROP;
+        }
+        option = new SwarmGpsrOption();
+        option->setDestinationPosition(destinationPosition);
+        attachGpsrOption(datagram, option);
+    }
+
+    Ipv4Address nextHop = findNextHop(destination, option);
+    if (nextHop.isUnspecified()) {
+        EV_WARN << "No next hop towards " << destination << ", dropping " << datagram->getName() << endl;
+        emit(droppedNoRouteSignal, 1L);
+        return DROP;
+    }
+    emit(option->getRoutingMode() == SWARM_GPSR_GREEDY ? greedyForwardedSignal : perimeterForwardedSignal, 1L);
+    option->setSenderAddress(selfAddress);
+    datagram->addTagIfAbsent<NextHopAddressReq>()->setNextHopAddress(nextHop);
+    datagram->addTagIfAbsent<InterfaceReq>()->setInterfaceId(outputInterfaceId);
+    return ACCEPT;
+}
+
+Ipv4Address SwarmGpsr::findNextHop(const Ipv4Address& destination, SwarmGpsrOption *option)
+{
+    if (neighbors.count(destination.getInt())) {
+        option->setRoutingMode(SWARM_GPSR_GREEDY);
+        return destination;
+    }
+    if (option->getRoutingMode() == SWARM_GPSR_GREEDY)
+        return findGreedyNextHop(destination, option);
+    else
+        return findPerimeterNextHop(destination, option);
+}
+
+Ipv4Address SwarmGpsr::findGreedyNextHop(const Ipv4Address& destination, SwarmGpsrOption *option)
+{
+    Coord selfPosition = getSelfPosition();
+    const Coord& destinationPosition = option->getDestinationPosition();
+    double bestDistance = (destinationPosition - selfPosition).length();
+    Ipv4Address bestNeighbor;
+    for (auto& it : neighbors) {
+        double distance = (destinationPosition - it.second.position).length();
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            bestNeighbor = Ipv4Address(it.first);
+        }
+    }
+    if (!bestNeighbor.isUnspecified())
+        return bestNeighbor;
+
+    // local maximum: walk the faces of the planar graph until we get closer
+    option->setRoutingMode(SWARM_GPSR_PERIMETER);
+    option->setPerimeterStartPosition(selfPosition);
+    option->setSenderAddress(L3Address());
+    option->setFaceFirstSenderAddress(selfAddress);
+    option->setFaceFirstReceiverAddress(L3Address());
+    return findPerimeterNextHop(destination, option);
+}
+
+Ipv4Address SwarmGpsr::findPerimeterNextHop(const Ipv4Address& destination, SwarmGpsrOption *option)
+{
+    Coord selfPosition = flat(getSelfPosition());
+    Coord startPosition = flat(option->getPerimeterStartPosition());
+    Coord destinationPosition = flat(option->getDestinationPosition());
+    if ((destinationPosition - selfPosition).length() < (destinationPosition - startPosition).length()) {
+        option->setRoutingMode(SWARM_GPSR_GREEDY);
+        return findGreedyNextHop(destination, option);
+    }
+
+    std::vector<Ipv4Address> planarNeighbors = getPlanarNeighbors();
+    if (planarNeighbors.empty())
+        return Ipv4Address::UNSPECIFIED_ADDRESS;
+
+    // right-hand rule: sweep counterclockwise from the edge we arrived on, or
+    // from the direction of the destination when entering perimeter mode here
+    const L3Address& sender = option->getSenderAddress();
+    double startAngle;
+    if (!sender.isUnspecified() && neighbors.count(sender.toIpv4().getInt()))
+        startAngle = getNeighborAngle(sender.toIpv4());
+    else
+        startAngle = std::atan2(destinationPosition.y - selfPosition.y, destinationPosition.x - selfPosition.x);
+    Ipv4Address nextHop = getNextPlanarNeighborCounterClockwise(planarNeighbors, startAngle);
+
+    // an edge crossing the start->destination line leads onto the next face
+    for (size_t i = 0; i < planarNeighbors.size() && !nextHop.isUnspecified(); i++) {
+        Coord nextPosition = flat(neighbors[nextHop.getInt()].position);
+        if (!segmentsIntersect(startPosition, destinationPosition, selfPosition, nextPosition))
+            break;
+        option->setFaceFirstSenderAddress(selfAddress);
+        option->setFaceFirstReceiverAddress(L3Address());
+        nextHop = getNextPlanarNeighborCounterClockwise(planarNeighbors, getNeighborAngle(nextHop));
+    }
+
+    // back on the first edge of the face: the destination is unreachable
+    if (option->getFaceFirstSenderAddress() == L3Address(selfAddress) && option->getFaceFirstReceiverAddress() == L3Address(nextHop))
+        return Ipv4Address::UNSPECIFIED_ADDRESS;
+    if (option->getFaceFirstReceiverAddress().isUnspecified())
+        option->setFaceFirstReceiverAddress(nextHop);
+    return nextHop;
+}
+
+std::vector<Ipv4Address> SwarmGpsr::getPlanarNeighbors() const
+{
+    // Gabriel graph: keep edge (self, u) unless another neighbor lies inside
+    // the circle whose diameter is that edge
+    std::vector<Ipv4Address> planarNeighbors;
+    Coord selfPosition = flat(getSelfPosition());
+    for (auto& u : neighbors) {
+        Coord uPosition = flat(u.second.position);
+        Coord center = (selfPosition + uPosition) / 2;
+        double radius = (uPosition - selfPosition).length() / 2;
+        bool witness = false;
+        for (auto& w : neighbors) {
+            if (w.first != u.first && (flat(w.second.position) - center).length() < radius) {
+                witness = true;
+                break;
+            }
+        }
+        if (!witness)
+            planarNeighbors.push_back(Ipv4Address(u.first));
+    }
+    return planarNeighbors;
+}
+
+Ipv4Address SwarmGpsr::getNextPlanarNeighborCounterClockwise(const std::vector<Ipv4Address>& planarNeighbors, double startAngle) const
+{
+    Ipv4Address bestNeighbor;
+    double bestDelta = std::numeric_limits<double>::infinity();
+    for (auto& neighbor : planarNeighbors) {
+        double delta = getNeighborAngle(neighbor) - startAngle;
+        while (delta <= 0)
+            delta += 2 * M_PI;
+        while (delta > 2 * M_PI)
+            delta -= 2 * M_PI;
+        if (delta < bestDelta) {
+            bestDelta = delta;
+            bestNeighbor = neighbor;
+        }
+    }
+    return bestNeighbor;
+}
+
+double SwarmGpsr::getNeighborAngle(const Ipv4Address& neighbor) const
+{
+    Coord selfPosition = getSelfPosition();
+    const Coord& neighborPosition = neighbors.at(neighbor.getInt()).position;
+    return std::atan2(neighborPosition.y - selfPosition.y, neighborPosition.x - selfPosition.x);
+}
+
+//-----------------------------------------------------------------------------------
+// Netfilter hooks
+//-----------------------------------------------------------------------------------
+
+INetfilter::IHook::Result SwarmGpsr::datagramPreRoutingHook(Packet *datagram)
+{
+    if (!isUp())
+        return ACCEPT;
+    const auto& ipv4Header = datagram->peekAtFront<Ipv4Header>();
+    if (ipv4Header->findOptionByType(IPOPTION_TLV_SWARM_POSITION) != nullptr)
+        learnFromTelemetry(ipv4Header);
+    Ipv4Address destination = ipv4Header->getDestAddress();
+    if (destination.isMulticast() || destination.isLimitedBroadcastAddress() || routingTable->isLocalAddress(destination))
+        return ACCEPT;
+    return routeDatagram(datagram, destination);
+}
+
+INetfilter::IHook::Result SwarmGpsr::datagramLocalOutHook(Packet *datagram)
+{
+    if (!isUp())
+        return ACCEPT;
+    const auto& ipv4Header = datagram->peekAtFront<Ipv4Header>();
+    Ipv4Address destination = ipv4Header->getDestAddress();
+    if (destination.isMulticast()) {
+        if (isTelemetryDatagram(datagram, ipv4Header)) {
+            lastTelemetrySent = simTime();
+            attachPositionOption(datagram);
+        }
+        return ACCEPT;
+    }
+    if (destination.isLimitedBroadcastAddress() || routingTable->isLocalAddress(destination))
+        return ACCEPT;
+    return routeDatagram(datagram, destination);
+}
+
+//-----------------------------------------------------------------------------------
+// Lifecycle
+//-----------------------------------------------------------------------------------
+
+void SwarmGpsr::handleStartOperation(LifecycleOperation *operation)
+{
+    NetworkInterface *ie = interfaceTable->findInterfaceByName(par("outputInterface"));
+    if (ie == nullptr)
+        throw cRuntimeError("Interface '%s' not found", par("outputInterface").stringValue());
+    outputInterfaceId = ie->getInterfaceId();
+    selfAddress = ie->getProtocolData<Ipv4InterfaceData>()->getIPAddress();
+    if (stationary)
+        stationaryRegistry[selfAddress.getInt()] = getSelfPosition();
+
+    socket.setOutputGate(gate("ipOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), beaconPort);
+    socket.setBroadcast(true);
+    socket.setTimeToLive(1);
+
+    scheduleAfter(uniform(0, maxJitter), beaconTimer);
+    scheduleAfter(neighborValidityInterval / 2, purgeTimer);
+}
+
+void SwarmGpsr::handleStopOperation(LifecycleOperation *operation)
+{
+    cancelEvent(beaconTimer);
+    cancelEvent(purgeTimer);
+    socket.close();
+    neighbors.clear();
+    locations.clear();
+}
+
+void SwarmGpsr::handleCrashOperation(LifecycleOperation *operation)
+{
+    cancelEvent(beaconTimer);
+    cancelEvent(purgeTimer);
+    socket.destroy();
+    neighbors.clear();
+    locations.clear();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,125 @@
+//===================================================================================
+// SWARM GPSR - Greedy Perimeter Stateless Routing for the FANET
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMGPSR_H
+#define __DRONESWARM_SWARMGPSR_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/common/geometry/common/Coord.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/networklayer/contract/INetfilter.h"
+#include "inet/networklayer/contract/IRoutingTable.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/networklayer/ipv4/Ipv4Header_m.h"
+#include "inet/routing/base/RoutingProtocolBase.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "routing/SwarmGpsr_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmGpsr : public RoutingProtocolBase, public NetfilterBase::HookBase, public UdpSocket::ICallback
+{
+  public:
+    struct NeighborEntry
+    {
+        Coord position;
+        simtime_t lastSeen;
+    };
+
+  protected:
+    // parameters
+    int telemetryPort = -1;
+    int beaconPort = -1;
+    simtime_t beaconInterval;
+    simtime_t maxJitter;
+    simtime_t neighborValidityInterval;
+    bool stationary = false;
+
+    // context
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    ModuleRefByPar<IRoutingTable> routingTable;
+    ModuleRefByPar<INetfilter> networkProtocol;
+    IMobility *mobility = nullptr;
+    int outputInterfaceId = -1;
+    Ipv4Address selfAddress;
+    UdpSocket socket;
+
+    // state
+    cMessage *beaconTimer = nullptr;
+    cMessage *purgeTimer = nullptr;
+    simtime_t lastTelemetrySent;
+    std::unordered_map<uint32_t, NeighborEntry> neighbors;  // one-hop, keyed by Ipv4Address::getInt()
+    std::unordered_map<uint32_t, NeighborEntry> locations;  // any swarm member heard via telemetry
+
+    // positions of stationary nodes (GCS); like INET's Gpsr global position table,
+    // this stands in for a location service for nodes that send no telemetry
+    static std::unordered_map<uint32_t, Coord> stationaryRegistry;
+
+    static simsignal_t beaconSentSignal;
+    static simsignal_t beaconSuppressedSignal;
+    static simsignal_t greedyForwardedSignal;
+    static simsignal_t perimeterForwardedSignal;
+    static simsignal_t droppedNoRouteSignal;
+    static simsignal_t neighborCountSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+    virtual void finish() override;
+
+    // beacons and position learning
+    void processBeaconTimer();
+    void processPurgeTimer();
+    void updateNeighbor(const Ipv4Address& address, const Coord& position);
+    void updateLocation(const Ipv4Address& address, const Coord& position);
+    Coord getSelfPosition() const;
+    bool lookupDestinationPosition(const Ipv4Address& destination, Coord& position) const;
+
+    // telemetry piggybacking
+    bool isTelemetryDatagram(Packet *datagram, const Ptr<const Ipv4Header>& ipv4Header) const;
+    void attachPositionOption(Packet *datagram);
+    void learnFromTelemetry(const Ptr<const Ipv4Header>& ipv4Header);
+
+    // forwarding
+    Result routeDatagram(Packet *datagram, const Ipv4Address& destination);
+    SwarmGpsrOption *getGpsrOptionForUpdate(Packet *datagram);
+    void attachGpsrOption(Packet *datagram, SwarmGpsrOption *option);
+    Ipv4Address findNextHop(const Ipv4Address& destination, SwarmGpsrOption *option);
+    Ipv4Address findGreedyNextHop(const Ipv4Address& destination, SwarmGpsrOption *option);
+    Ipv4Address findPerimeterNextHop(const Ipv4Address& destination, SwarmGpsrOption *option);
+    std::vector<Ipv4Address> getPlanarNeighbors() const;
+    Ipv4Address getNextPlanarNeighborCounterClockwise(const std::vector<Ipv4Address>& planarNeighbors, double startAngle) const;
+    double getNeighborAngle(const Ipv4Address& neighbor) const;
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmGpsr();
+
+    // netfilter
+    virtual Result datagramPreRoutingHook(Packet *datagram) override;
+    virtual Result datagramForwardHook(Packet *datagram) override { return ACCEPT; }
+    virtual Result datagramPostRoutingHook(Packet *datagram) override { return ACCEPT; }
+    virtual Result datagramLocalInHook(Packet *datagram) override { return ACCEPT; }
+    virtual Result datagramLocalOutHook(Packet *datagram) override;
+};
+
+} // namespace droneswarm
+
+#endif
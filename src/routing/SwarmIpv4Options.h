@@ -0,0 +1,50 @@
+//===================================================================================
+// SWARM IPV4 OPTIONS - Helpers for the project's Ipv4 TLV options
+//===================================================================================
+// Routing/dissemination modules piggyback small per-datagram state (sender
+// position, originator/sequence, GPSR state) as Ipv4 TLV options from their
+// netfilter hooks, the same way INET's Gpsr carries its GpsrOption.
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMIPV4OPTIONS_H
+#define __DRONESWARM_SWARMIPV4OPTIONS_H
+
+#include "inet/common/packet/Packet.h"
+#include "inet/networklayer/common/L3Tools.h"
+#include "inet/networklayer/ipv4/Ipv4Header_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+/** Adds the option to the datagram's Ipv4 header, fixing up the header and total lengths. */
+inline void insertIpv4Option(Packet *datagram, TlvOptionBase *option)
+{
+    datagram->trimFront();
+    auto ipv4Header = removeNetworkProtocolHeader<Ipv4Header>(datagram);
+    B oldHlen = ipv4Header->calculateHeaderByteLength();
+    ipv4Header->addOption(option);
+    B newHlen = ipv4Header->calculateHeaderByteLength();
+    ipv4Header->setHeaderLength(newHlen);
+    ipv4Header->addChunkLength(newHlen - oldHlen);
+    ipv4Header->setTotalLengthField(ipv4Header->getTotalLengthField() + newHlen - oldHlen);
+    insertNetworkProtocolHeader(datagram, Protocol::ipv4, ipv4Header);
+}
+
+/**
+ * Returns the option of the given type in a mutable form, or nullptr. The
+ * option stays owned by the header inside the datagram.
+ */
+template <typename T>
+T *findMutableIpv4Option(Packet *datagram, short optionType)
+{
+    datagram->trimFront();
+    auto ipv4Header = removeNetworkProtocolHeader<Ipv4Header>(datagram);
+    T *option = check_and_cast_nullable<T *>(ipv4Header->findMutableOptionByType(optionType));
+    insertNetworkProtocolHeader(datagram, Protocol::ipv4, ipv4Header);
+    return option;
+}
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,512 @@
+//===================================================================================
+// SWARM OLSR - Optimized Link State Routing for the FANET
+//===================================================================================
+
+#include "routing/SwarmOlsr.h"
+
+#include "inet/linklayer/common/InterfaceTag_m.h"
+#include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmOlsr);
+
+simsignal_t SwarmOlsr::helloSentSignal = cComponent::registerSignal("helloSent");
+simsignal_t SwarmOlsr::tcSentSignal = cComponent::registerSignal("tcSent");
+simsignal_t SwarmOlsr::tcForwardedSignal = cComponent::registerSignal("tcForwarded");
+simsignal_t SwarmOlsr::mprSetSizeSignal = cComponent::registerSignal("mprSetSize");
+simsignal_t SwarmOlsr::mprUpdateSignal = cComponent::registerSignal("mprUpdate");
+
+// RFC 3626 sec. 19: sequence number comparison with wrap-around
+static bool isNewer(uint16_t a, uint16_t b)
+{
+    return (a > b && a - b <= 32768) || (a < b && b - a > 32768);
+}
+
+SwarmOlsr::~SwarmOlsr()
+{
+    cancelAndDelete(helloTimer);
+    cancelAndDelete(tcTimer);
+    cancelAndDelete(purgeTimer);
+    cancelAndDelete(routeTimer);
+}
+
+void SwarmOlsr::initialize(int stage)
+{
+    RoutingProtocolBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        olsrPort = par("olsrPort");
+        helloInterval = par("helloInterval");
+        tcInterval = par("tcInterval");
+        maxJitter = par("maxJitter");
+        neighborHoldTime = par("neighborHoldTime");
+        topologyHoldTime = par("topologyHoldTime");
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        routingTable.reference(this, "routingTableModule", true);
+        helloTimer = new cMessage("HelloTimer");
+        tcTimer = new cMessage("TcTimer");
+        purgeTimer = new cMessage("PurgeTimer");
+        routeTimer = new cMessage("RouteTimer");
+    }
+}
+
+void SwarmOlsr::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg == helloTimer) {
+        sendHello();
+        scheduleAfter(helloInterval - uniform(0, maxJitter), helloTimer);
+    }
+    else if (msg == tcTimer) {
+        if (!mprSelectors.empty())
+            sendTc();
+        scheduleAfter(tcInterval - uniform(0, maxJitter), tcTimer);
+    }
+    else if (msg == purgeTimer) {
+        purge();
+        scheduleAfter(helloInterval, purgeTimer);
+    }
+    else if (msg == routeTimer)
+        updateRoutes();
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+//-----------------------------------------------------------------------------------
+// HELLO / TC
+//-----------------------------------------------------------------------------------
+
+void SwarmOlsr::sendHello()
+{
+    auto hello = makeShared<SwarmOlsrHello>();
+    hello->setOriginator(Ipv4Address(self));
+    hello->setSequence(helloSequence++);
+    for (auto& it : links) {
+        if (symNeighbors.count(it.first))
+            hello->appendSymNeighbors(Ipv4Address(it.first));
+        else
+            hello->appendAsymNeighbors(Ipv4Address(it.first));
+    }
+    for (NodeId mpr : mprs)
+        hello->appendMprs(Ipv4Address(mpr));
+    hello->setChunkLength(B(8 + 4 * (links.size() + mprs.size())));
+    sendControl(hello, "SwarmOlsrHello");
+    emit(helloSentSignal, 1L);
+}
+
+void SwarmOlsr::sendTc()
+{
+    auto tc = makeShared<SwarmOlsrTc>();
+    tc->setOriginator(Ipv4Address(self));
+    tc->setSequence(tcSequence++);
+    tc->setAnsn(ansn);
+    tc->setTimeToLive(255);
+    tc->setHopCount(0);
+    for (auto& it : mprSelectors)
+        tc->appendAdvertisedSelectors(Ipv4Address(it.first));
+    tc->setChunkLength(B(12 + 4 * mprSelectors.size()));
+    sendControl(tc, "SwarmOlsrTc");
+    emit(tcSentSignal, 1L);
+}
+
+void SwarmOlsr::sendControl(const Ptr<const Chunk>& chunk, const char *name)
+{
+    auto packet = new Packet(name, chunk);
+    packet->addTag<InterfaceReq>()->setInterfaceId(outputInterface->getInterfaceId());
+    socket.sendTo(packet, Ipv4Address::ALLONES_ADDRESS, olsrPort);
+}
+
+void SwarmOlsr::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    const auto& chunk = packet->peekAtFront<Chunk>();
+    if (auto hello = dynamicPtrCast<const SwarmOlsrHello>(chunk))
+        processHello(hello);
+    else if (auto tc = dynamicPtrCast<const SwarmOlsrTc>(chunk))
+        processTc(tc, packet->getTag<L3AddressInd>()->getSrcAddress().toIpv4().getInt());
+    delete packet;
+    if (mprDirty)
+        updateMprs();
+}
+
+void SwarmOlsr::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmOlsr::processHello(const Ptr<const SwarmOlsrHello>& hello)
+{
+    NodeId sender = hello->getOriginator().toIpv4().getInt();
+    if (sender == self)
+        return;
+
+    auto& link = links[sender];
+    link.heardTime = simTime();
+    bool listsUs = false;
+    for (size_t i = 0; i < hello->getSymNeighborsArraySize() && !listsUs; i++)
+        listsUs = hello->getSymNeighbors(i).toIpv4().getInt() == self;
+    for (size_t i = 0; i < hello->getAsymNeighborsArraySize() && !listsUs; i++)
+        listsUs = hello->getAsymNeighbors(i).toIpv4().getInt() == self;
+    if (listsUs) {
+        link.symTime = simTime();
+        if (!symNeighbors.count(sender))
+            addSymNeighbor(sender);
+    }
+    if (!symNeighbors.count(sender))
+        return;
+
+    std::set<NodeId> twoHops;
+    for (size_t i = 0; i < hello->getSymNeighborsArraySize(); i++) {
+        NodeId node = hello->getSymNeighbors(i).toIpv4().getInt();
+        if (node != self)
+            twoHops.insert(node);
+    }
+    setTwoHops(sender, twoHops);
+
+    bool selectsUs = false;
+    for (size_t i = 0; i < hello->getMprsArraySize() && !selectsUs; i++)
+        selectsUs = hello->getMprs(i).toIpv4().getInt() == self;
+    if (selectsUs) {
+        if (!mprSelectors.count(sender))
+            ansn++;
+        mprSelectors[sender] = simTime();
+    }
+    else if (mprSelectors.erase(sender))
+        ansn++;
+}
+
+void SwarmOlsr::processTc(const Ptr<const SwarmOlsrTc>& tc, NodeId lastHop)
+{
+    NodeId originator = tc->getOriginator().toIpv4().getInt();
+    if (originator == self || !symNeighbors.count(lastHop))
+        return;
+    auto last = lastSequence.find(originator);
+    if (last != lastSequence.end() && !isNewer(tc->getSequence(), last->second))
+        return;
+    lastSequence[originator] = tc->getSequence();
+
+    auto& entry = topology[originator];
+    if (entry.selectors.empty() || !isNewer(entry.ansn, tc->getAnsn())) {
+        std::set<NodeId> selectors;
+        for (size_t i = 0; i < tc->getAdvertisedSelectorsArraySize(); i++)
+            selectors.insert(tc->getAdvertisedSelectors(i).toIpv4().getInt());
+        entry.ansn = tc->getAnsn();
+        entry.expiry = simTime() + topologyHoldTime;
+        if (selectors != entry.selectors) {
+            entry.selectors = selectors;
+            scheduleRouteUpdate();
+        }
+    }
+
+    // default forwarding rule: only MPRs of the previous hop re-broadcast
+    if (mprSelectors.count(lastHop) && tc->getTimeToLive() > 1) {
+        auto copy = staticPtrCast<SwarmOlsrTc>(tc->dupShared());
+        copy->setTimeToLive(tc->getTimeToLive() - 1);
+        copy->setHopCount(tc->getHopCount() + 1);
+        sendControl(copy, "SwarmOlsrTc");
+        emit(tcForwardedSignal, 1L);
+    }
+}
+
+void SwarmOlsr::purge()
+{
+    simtime_t now = simTime();
+    for (auto it = links.begin(); it != links.end();) {
+        NodeId neighbor = it->first;
+        bool lost = it->second.heardTime + neighborHoldTime < now;
+        if ((lost || it->second.symTime + neighborHoldTime < now) && symNeighbors.count(neighbor))
+            removeSymNeighbor(neighbor);
+        if (lost)
+            it = links.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = mprSelectors.begin(); it != mprSelectors.end();) {
+        if (it->second + neighborHoldTime < now) {
+            it = mprSelectors.erase(it);
+            ansn++;
+        }
+        else
+            ++it;
+    }
+    for (auto it = topology.begin(); it != topology.end();) {
+        if (it->second.expiry < now) {
+            it = topology.erase(it);
+            scheduleRouteUpdate();
+        }
+        else
+            ++it;
+    }
+    if (mprDirty)
+        updateMprs();
+}
+
+//-----------------------------------------------------------------------------------
+// Neighborhood and incremental MPR selection
+//-----------------------------------------------------------------------------------
+
+bool SwarmOlsr::isStrictTwoHop(NodeId node) const
+{
+    return node != self && !symNeighbors.count(node) && reachers.count(node);
+}
+
+void SwarmOlsr::addSymNeighbor(NodeId neighbor)
+{
+    symNeighbors.insert(neighbor);
+    // a former 2-hop node that became a neighbor no longer needs an MPR
+    uncovered.erase(neighbor);
+    mprDirty = true;
+    scheduleRouteUpdate();
+}
+
+void SwarmOlsr::removeSymNeighbor(NodeId neighbor)
+{
+    if (mprs.count(neighbor))
+        removeMpr(neighbor);
+    setTwoHops(neighbor, {});
+    twoHopOf.erase(neighbor);
+    symNeighbors.erase(neighbor);
+    if (mprSelectors.erase(neighbor))
+        ansn++;
+    if (isStrictTwoHop(neighbor) && coverage[neighbor] == 0)
+        uncovered.insert(neighbor);
+    mprDirty = true;
+    scheduleRouteUpdate();
+}
+
+void SwarmOlsr::setTwoHops(NodeId neighbor, const std::set<NodeId>& twoHops)
+{
+    auto& old = twoHopOf[neighbor];
+    if (old == twoHops)
+        return;
+    bool isMpr = mprs.count(neighbor);
+    for (NodeId node : old) {
+        if (twoHops.count(node))
+            continue;
+        auto& nodeReachers = reachers[node];
+        nodeReachers.erase(neighbor);
+        if (nodeReachers.empty()) {
+            reachers.erase(node);
+            coverage.erase(node);
+            uncovered.erase(node);
+        }
+        else if (isMpr && --coverage[node] == 0 && isStrictTwoHop(node))
+            uncovered.insert(node);
+    }
+    for (NodeId node : twoHops) {
+        if (old.count(node))
+            continue;
+        reachers[node].insert(neighbor);
+        int& covered = coverage[node];
+        if (isMpr)
+            covered++;
+        if (covered == 0 && isStrictTwoHop(node))
+            uncovered.insert(node);
+    }
+    old = twoHops;
+    mprDirty = true;
+    scheduleRouteUpdate();
+}
+
+void SwarmOlsr::addMpr(NodeId neighbor)
+{
+    mprs.insert(neighbor);
+    for (NodeId node : twoHopOf[neighbor]) {
+        coverage[node]++;
+        uncovered.erase(node);
+    }
+}
+
+void SwarmOlsr::removeMpr(NodeId neighbor)
+{
+    mprs.erase(neighbor);
+    for (NodeId node : twoHopOf[neighbor])
+        if (--coverage[node] == 0 && isStrictTwoHop(node))
+            uncovered.insert(node);
+}
+
+void SwarmOlsr::updateMprs()
+{
+    // only the 2-hop nodes left uncovered by the last neighborhood changes are
+    // considered; the rest of the MPR set is kept as is
+    mprDirty = false;
+    emit(mprUpdateSignal, 1L);
+    bool changed = false;
+
+    // nodes reachable through a single neighbor force that neighbor
+    std::vector<NodeId> forced;
+    for (NodeId node : uncovered)
+        if (reachers[node].size() == 1)
+            forced.push_back(*reachers[node].begin());
+    for (NodeId neighbor : forced) {
+        if (!mprs.count(neighbor)) {
+            addMpr(neighbor);
+            changed = true;
+        }
+    }
+
+    // then greedily the neighbor covering most of what is still uncovered
+    while (!uncovered.empty()) {
+        std::map<NodeId, int> gain;
+        for (NodeId node : uncovered)
+            for (NodeId neighbor : reachers[node])
+                gain[neighbor]++;
+        NodeId best = 0;
+        int bestGain = 0;
+        size_t bestDegree = 0;
+        for (auto& it : gain) {
+            size_t degree = twoHopOf[it.first].size();
+            if (it.second > bestGain || (it.second == bestGain && degree > bestDegree)) {
+                best = it.first;
+                bestGain = it.second;
+                bestDegree = degree;
+            }
+        }
+        if (bestGain == 0)
+            break;
+        addMpr(best);
+        changed = true;
+    }
+
+    // drop MPRs whose whole 2-hop set is covered at least twice
+    std::vector<NodeId> candidates(mprs.begin(), mprs.end());
+    for (NodeId mpr : candidates) {
+        bool redundant = true;
+        for (NodeId node : twoHopOf[mpr]) {
+            if (isStrictTwoHop(node) && coverage[node] < 2) {
+                redundant = false;
+                break;
+            }
+        }
+        if (redundant) {
+            removeMpr(mpr);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        emit(mprSetSizeSignal, (long)mprs.size());
+}
+
+void SwarmOlsr::scheduleRouteUpdate()
+{
+    if (!routeTimer->isScheduled())
+        scheduleAfter(SIMTIME_ZERO, routeTimer);
+}
+
+void SwarmOlsr::updateRoutes()
+{
+    // breadth-first over 1-hop, 2-hop and TC links (RFC 3626 sec. 10)
+    struct Hop { NodeId nextHop; int hops; };
+    std::map<NodeId, Hop> routes;
+    for (NodeId neighbor : symNeighbors)
+        routes[neighbor] = { neighbor, 1 };
+    for (NodeId neighbor : symNeighbors)
+        for (NodeId node : twoHopOf[neighbor])
+            if (node != self && !routes.count(node))
+                routes[node] = { neighbor, 2 };
+    for (int hops = 2; ; hops++) {
+        bool added = false;
+        for (auto& it : topology) {
+            auto lastHop = routes.find(it.first);
+            if (lastHop == routes.end() || lastHop->second.hops != hops)
+                continue;
+            for (NodeId node : it.second.selectors) {
+                if (node != self && !routes.count(node)) {
+                    routes[node] = { lastHop->second.nextHop, hops + 1 };
+                    added = true;
+                }
+            }
+        }
+        if (!added)
+            break;
+    }
+
+    // touch only the routes that changed
+    for (auto it = installedRoutes.begin(); it != installedRoutes.end();) {
+        auto route = routes.find(it->first);
+        if (route == routes.end() || it->second->getNextHopAsGeneric().toIpv4().getInt() != route->second.nextHop
+                || it->second->getMetric() != route->second.hops)
+        {
+            routingTable->deleteRoute(it->second);
+            it = installedRoutes.erase(it);
+        }
+        else
+            ++it;
+    }
+    for (auto& it : routes) {
+        if (installedRoutes.count(it.first))
+            continue;
+        IRoute *route = routingTable->createRoute();
+        route->setSourceType(IRoute::MANET);
+        route->setSource(this);
+        route->setDestination(Ipv4Address(it.first));
+        route->setPrefixLength(32);
+        route->setNextHop(Ipv4Address(it.second.nextHop));
+        route->setInterface(outputInterface);
+        route->setMetric(it.second.hops);
+        routingTable->addRoute(route);
+        installedRoutes[it.first] = route;
+    }
+}
+
+//-----------------------------------------------------------------------------------
+// Lifecycle
+//-----------------------------------------------------------------------------------
+
+void SwarmOlsr::handleStartOperation(LifecycleOperation *operation)
+{
+    outputInterface = interfaceTable->findInterfaceByName(par("outputInterface"));
+    if (outputInterface == nullptr)
+        throw cRuntimeError("Interface '%s' not found", par("outputInterface").stringValue());
+    self = outputInterface->getProtocolData<Ipv4InterfaceData>()->getIPAddress().getInt();
+
+    socket.setOutputGate(gate("ipOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), olsrPort);
+    socket.setBroadcast(true);
+    socket.setTimeToLive(1);
+
+    scheduleAfter(uniform(0, maxJitter), helloTimer);
+    scheduleAfter(helloInterval + uniform(0, maxJitter), tcTimer);
+    scheduleAfter(helloInterval, purgeTimer);
+}
+
+void SwarmOlsr::handleStopOperation(LifecycleOperation *operation)
+{
+    socket.close();
+    clearState();
+}
+
+void SwarmOlsr::handleCrashOperation(LifecycleOperation *operation)
+{
+    socket.destroy();
+    clearState();
+}
+
+void SwarmOlsr::clearState()
+{
+    cancelEvent(helloTimer);
+    cancelEvent(tcTimer);
+    cancelEvent(purgeTimer);
+    cancelEvent(routeTimer);
+    for (auto& it : installedRoutes)
+        routingTable->deleteRoute(it.second);
+    installedRoutes.clear();
+    links.clear();
+    symNeighbors.clear();
+    twoHopOf.clear();
+    reachers.clear();
+    mprSelectors.clear();
+    mprs.clear();
+    coverage.clear();
+    uncovered.clear();
+    topology.clear();
+    lastSequence.clear();
+    mprDirty = false;
+}
+
+} // namespace droneswarm
@@ -0,0 +1,134 @@
+//===================================================================================
+// SWARM OLSR - Optimized Link State Routing for the FANET
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMOLSR_H
+#define __DRONESWARM_SWARMOLSR_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/networklayer/contract/IRoutingTable.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/routing/base/RoutingProtocolBase.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "routing/SwarmOlsr_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmOlsr : public RoutingProtocolBase, public UdpSocket::ICallback
+{
+  protected:
+    typedef uint32_t NodeId;    // Ipv4Address::getInt()
+
+    struct LinkEntry
+    {
+        simtime_t heardTime;    // last HELLO from this neighbor
+        simtime_t symTime;      // last HELLO that listed us
+    };
+
+    struct TopologyEntry
+    {
+        uint16_t ansn = 0;
+        std::set<NodeId> selectors;
+        simtime_t expiry;
+    };
+
+    // parameters
+    int olsrPort = -1;
+    simtime_t helloInterval;
+    simtime_t tcInterval;
+    simtime_t maxJitter;
+    simtime_t neighborHoldTime;
+    simtime_t topologyHoldTime;
+
+    // context
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    ModuleRefByPar<IRoutingTable> routingTable;
+    NetworkInterface *outputInterface = nullptr;
+    NodeId self = 0;
+    UdpSocket socket;
+
+    // timers
+    cMessage *helloTimer = nullptr;
+    cMessage *tcTimer = nullptr;
+    cMessage *purgeTimer = nullptr;
+    cMessage *routeTimer = nullptr;     // coalesces route recomputations
+
+    // link sensing and neighborhood
+    std::map<NodeId, LinkEntry> links;
+    std::set<NodeId> symNeighbors;
+    std::map<NodeId, std::set<NodeId>> twoHopOf;    // sym neighbor -> its sym neighbors
+    std::map<NodeId, std::set<NodeId>> reachers;    // 2-hop node -> sym neighbors reaching it
+    std::map<NodeId, simtime_t> mprSelectors;
+
+    // incremental MPR state
+    std::set<NodeId> mprs;
+    std::map<NodeId, int> coverage;                 // 2-hop node -> MPRs covering it
+    std::set<NodeId> uncovered;                     // strict 2-hop nodes with coverage 0
+    bool mprDirty = false;
+
+    // topology and routes
+    std::map<NodeId, TopologyEntry> topology;
+    std::map<NodeId, uint16_t> lastSequence;        // TC duplicate detection
+    std::map<NodeId, IRoute *> installedRoutes;
+    uint16_t helloSequence = 0;
+    uint16_t tcSequence = 0;
+    uint16_t ansn = 0;
+
+    static simsignal_t helloSentSignal;
+    static simsignal_t tcSentSignal;
+    static simsignal_t tcForwardedSignal;
+    static simsignal_t mprSetSizeSignal;
+    static simsignal_t mprUpdateSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+
+    // HELLO / TC
+    void sendHello();
+    void sendTc();
+    void sendControl(const Ptr<const Chunk>& chunk, const char *name);
+    void processHello(const Ptr<const SwarmOlsrHello>& hello);
+    void processTc(const Ptr<const SwarmOlsrTc>& tc, NodeId lastHop);
+    void purge();
+
+    // neighborhood bookkeeping, each keeps the MPR counters consistent
+    void addSymNeighbor(NodeId neighbor);
+    void removeSymNeighbor(NodeId neighbor);
+    void setTwoHops(NodeId neighbor, const std::set<NodeId>& twoHops);
+    bool isStrictTwoHop(NodeId node) const;
+    void updateMprs();
+    void addMpr(NodeId neighbor);
+    void removeMpr(NodeId neighbor);
+    void scheduleRouteUpdate();
+    void updateRoutes();
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+    void clearState();
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmOlsr();
+
+    /** True if the neighbor selected this node as one of its MPRs. */
+    bool isMprSelector(const Ipv4Address& neighbor) const { return mprSelectors.count(neighbor.getInt()) != 0; }
+};
+
+} // namespace droneswarm
+
+#endif
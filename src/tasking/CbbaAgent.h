@@ -0,0 +1,298 @@
+//===================================================================================
+// CBBA AGENT - Consensus-based bundle algorithm, one agent's state
+//===================================================================================
+// Phase 1 (bundle construction): greedily add the task with the largest
+// marginal score to the bundle, inserted at its best position in the path,
+// while the score beats the current winning bid. Scores are time-discounted
+// rewards, sum of discount^(arrival time) along the path, which have
+// diminishing marginal gain, the condition for CBBA's convergence.
+//
+// Phase 2 (consensus): merge a neighbor's winning bids and winners with the
+// decision table of Choi, Brunet & How (2009), Table 1, using the
+// per-agent information timestamps; a task won by someone else releases it
+// and every task added to the bundle after it.
+//
+// Winners are agent ids, NONE if unassigned; ties go to the lower id. With
+// bidResolution > 0 scores are rounded to it, as they are on the wire.
+//
+// Ref: Choi, Brunet & How (2009) "Consensus-based decentralized auctions for
+//      robust task allocation", IEEE Trans. Robotics
+//===================================================================================
+
+#ifndef __DRONESWARM_CBBAAGENT_H
+#define __DRONESWARM_CBBAAGENT_H
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace droneswarm {
+
+class CbbaAgent
+{
+  public:
+    static const int NONE = -1;
+
+    struct Task
+    {
+        double x = 0;
+        double y = 0;
+    };
+
+    struct Bid
+    {
+        int task = 0;
+        int winner = NONE;
+        double bid = 0;
+    };
+
+  protected:
+    int self = NONE;
+    std::vector<Task> tasks;
+    int maxBundle = 0;
+    double discount = 1;        // reward factor per second of travel
+    double speed = 1;
+    double bidResolution = 0;
+    double x = 0;               // agent position, fixed for the allocation
+    double y = 0;
+
+    std::vector<double> winningBids;
+    std::vector<int> winners;
+    std::unordered_map<int, double> timestamps;     // agent -> time of its freshest information
+    std::vector<int> bundle;                        // in order of addition
+    std::vector<int> path;                          // in order of visit
+
+    static constexpr double EPSILON = 1e-9;
+
+    static bool outbids(double bid1, int agent1, double bid2, int agent2)
+    {
+        return bid1 > bid2 + EPSILON || (std::abs(bid1 - bid2) <= EPSILON && agent1 != NONE && (agent2 == NONE || agent1 < agent2));
+    }
+
+    double getPathScore(const std::vector<int>& candidate) const
+    {
+        double score = 0;
+        double time = 0;
+        double px = x, py = y;
+        for (int task : candidate) {
+            time += std::hypot(tasks[task].x - px, tasks[task].y - py) / speed;
+            px = tasks[task].x;
+            py = tasks[task].y;
+            score += std::pow(discount, time);
+        }
+        return score;
+    }
+
+    /** Marginal score of task j at its best insertion point. */
+    double getMarginalScore(int j, int& position) const
+    {
+        double base = getPathScore(path);
+        double best = -1;
+        std::vector<int> candidate;
+        for (int n = 0; n <= (int)path.size(); n++) {
+            candidate = path;
+            candidate.insert(candidate.begin() + n, j);
+            double gain = getPathScore(candidate) - base;
+            if (bidResolution > 0)
+                gain = std::round(gain / bidResolution) * bidResolution;
+            if (gain > best) {
+                best = gain;
+                position = n;
+            }
+        }
+        return best;
+    }
+
+    double getTimestamp(const std::unordered_map<int, double>& times, int agent) const
+    {
+        auto it = times.find(agent);
+        return it == times.end() ? -INFINITY : it->second;
+    }
+
+  public:
+    CbbaAgent() {}
+    CbbaAgent(int self, const std::vector<Task>& tasks, int maxBundle, double discount, double speed, double bidResolution = 0) :
+        self(self), tasks(tasks), maxBundle(maxBundle), discount(discount), speed(speed), bidResolution(bidResolution),
+        winningBids(tasks.size(), 0), winners(tasks.size(), NONE) {}
+
+    void setPosition(double px, double py) { x = px; y = py; }
+
+    /** Phase 1; true if the bundle grew. */
+    bool buildBundle()
+    {
+        bool changed = false;
+        while ((int)bundle.size() < maxBundle) {
+            int bestTask = NONE;
+            int bestPosition = 0;
+            double bestScore = 0;
+            for (int j = 0; j < (int)tasks.size(); j++) {
+                if (winners[j] == self)
+                    continue;
+                int position = 0;
+                double score = getMarginalScore(j, position);
+                if (outbids(score, self, winningBids[j], winners[j]) && score > bestScore + EPSILON) {
+                    bestTask = j;
+                    bestPosition = position;
+                    bestScore = score;
+                }
+            }
+            if (bestTask == NONE)
+                break;
+            bundle.push_back(bestTask);
+            path.insert(path.begin() + bestPosition, bestTask);
+            winningBids[bestTask] = bestScore;
+            winners[bestTask] = self;
+            changed = true;
+        }
+        return changed;
+    }
+
+    /**
+     * Phase 2: merge the bids of neighbor sender (tasks without a winner
+     * omitted) and its timestamps, received at time now. True if any winner
+     * changed.
+     */
+    bool merge(int sender, const std::vector<Bid>& senderBids, const std::unordered_map<int, double>& senderTimes, double now)
+    {
+        std::vector<double> y(tasks.size(), 0);
+        std::vector<int> z(tasks.size(), NONE);
+        for (const auto& bid : senderBids) {
+            if (bid.task >= 0 && bid.task < (int)tasks.size()) {
+                y[bid.task] = bid.bid;
+                z[bid.task] = bid.winner;
+            }
+        }
+
+        bool changed = false;
+        auto update = [&] (int j) {
+            changed |= winners[j] != z[j];
+            winningBids[j] = y[j];
+            winners[j] = z[j];
+        };
+        auto reset = [&] (int j) {
+            changed |= winners[j] != NONE;
+            winningBids[j] = 0;
+            winners[j] = NONE;
+        };
+        // sender's information about agent m is newer than ours
+        auto newer = [&] (int m) { return getTimestamp(senderTimes, m) > getTimestamp(timestamps, m); };
+        auto older = [&] (int m) { return getTimestamp(senderTimes, m) < getTimestamp(timestamps, m); };
+
+        const int k = sender;
+        const int i = self;
+        for (int j = 0; j < (int)tasks.size(); j++) {
+            int zk = z[j];
+            int zi = winners[j];
+            if (zk == k) {
+                if (zi == i) {
+                    if (outbids(y[j], k, winningBids[j], i))
+                        update(j);
+                }
+                else if (zi == k || zi == NONE)
+                    update(j);
+                else if (newer(zi) || outbids(y[j], k, winningBids[j], zi))
+                    update(j);
+            }
+            else if (zk == i) {
+                if (zi == k)
+                    reset(j);
+                else if (zi != i && zi != NONE && newer(zi))
+                    reset(j);
+            }
+            else if (zk != NONE) {
+                const int m = zk;
+                if (zi == i) {
+                    if (newer(m) && outbids(y[j], m, winningBids[j], i))
+                        update(j);
+                }
+                else if (zi == k) {
+                    if (newer(m))
+                        update(j);
+                    else
+                        reset(j);
+                }
+                else if (zi == m) {
+                    if (newer(m))
+                        update(j);
+                }
+                else if (zi != NONE) {
+                    const int n = zi;
+                    if (newer(m) && newer(n))
+                        update(j);
+                    else if (newer(m) && outbids(y[j], m, winningBids[j], n))
+                        update(j);
+                    else if (newer(n) && older(m))
+                        reset(j);
+                }
+                else if (newer(m))
+                    update(j);
+            }
+            else {
+                if (zi == k)
+                    update(j);
+                else if (zi != i && zi != NONE && newer(zi))
+                    update(j);
+            }
+        }
+
+        timestamps[k] = now;
+        for (const auto& it : senderTimes)
+            if (it.first != i && it.first != k && it.second > getTimestamp(timestamps, it.first))
+                timestamps[it.first] = it.second;
+
+        releaseOutbid();
+        return changed;
+    }
+
+    /** Drops the first outbid task of the bundle and everything added after it. */
+    void releaseOutbid()
+    {
+        for (size_t n = 0; n < bundle.size(); n++) {
+            if (winners[bundle[n]] == self)
+                continue;
+            for (size_t m = n; m < bundle.size(); m++) {
+                int task = bundle[m];
+                if (m > n && winners[task] == self) {
+                    winningBids[task] = 0;
+                    winners[task] = NONE;
+                }
+                for (auto it = path.begin(); it != path.end(); ++it) {
+                    if (*it == task) {
+                        path.erase(it);
+                        break;
+                    }
+                }
+            }
+            bundle.resize(n);
+            return;
+        }
+    }
+
+    /** Non-empty winners, as sent to the neighbors. */
+    std::vector<Bid> getBids() const
+    {
+        std::vector<Bid> bids;
+        for (int j = 0; j < (int)tasks.size(); j++)
+            if (winners[j] != NONE)
+                bids.push_back({j, winners[j], winningBids[j]});
+        return bids;
+    }
+
+    const std::unordered_map<int, double>& getTimestamps() const { return timestamps; }
+    const std::vector<int>& getWinners() const { return winners; }
+    const std::vector<int>& getBundle() const { return bundle; }
+    const std::vector<int>& getPath() const { return path; }
+    int getNumTasks() const { return tasks.size(); }
+
+    double getBundleScore() const
+    {
+        double score = 0;
+        for (int task : bundle)
+            score += winningBids[task];
+        return score;
+    }
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,257 @@
+//===================================================================================
+// SWARM TASK ALLOCATION APP - CBBA auction of SAR search cells
+//===================================================================================
+
+#include "tasking/SwarmTaskAllocationApp.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "inet/networklayer/common/HopLimitTag_m.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmTaskAllocationApp);
+
+simsignal_t SwarmTaskAllocationApp::bidsSentSignal = cComponent::registerSignal("bidsSent");
+simsignal_t SwarmTaskAllocationApp::bidsReceivedSignal = cComponent::registerSignal("bidsReceived");
+simsignal_t SwarmTaskAllocationApp::assignmentChangeSignal = cComponent::registerSignal("assignmentChange");
+
+static const double BID_RESOLUTION = 1.0 / 65535;   // bids are sent as uint16
+
+static int varintLength(uint64_t value)
+{
+    int length = 1;
+    for (; value >= 0x80; value >>= 7)
+        length++;
+    return length;
+}
+
+SwarmTaskAllocationApp::~SwarmTaskAllocationApp()
+{
+    cancelAndDelete(timer);
+}
+
+void SwarmTaskAllocationApp::initialize(int stage)
+{
+    ApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        nodeId = par("nodeId");
+        port = par("port");
+        startTime = par("startTime");
+        stopTime = par("stopTime");
+        if (stopTime >= SIMTIME_ZERO && stopTime < startTime)
+            throw cRuntimeError("Invalid startTime/stopTime parameters");
+        minBroadcastInterval = par("minBroadcastInterval");
+        minHeartbeatInterval = par("minHeartbeatInterval");
+        maxHeartbeatInterval = par("maxHeartbeatInterval");
+        if (minHeartbeatInterval <= SIMTIME_ZERO || maxHeartbeatInterval < minHeartbeatInterval)
+            throw cRuntimeError("Invalid minHeartbeatInterval/maxHeartbeatInterval parameters");
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        mobility.reference(this, "mobilityModule", true);
+        agent = CbbaAgent(nodeId, createTasks(), par("maxBundle").intValue(), par("discount").doubleValue(), par("cruiseSpeed").doubleValue(), BID_RESOLUTION);
+        timer = new cMessage("TaskAllocationTimer");
+    }
+}
+
+std::vector<CbbaAgent::Task> SwarmTaskAllocationApp::createTasks() const
+{
+    double minX = par("areaMinX");
+    double minY = par("areaMinY");
+    double maxX = par("areaMaxX");
+    double maxY = par("areaMaxY");
+    double cellSize = par("cellSize");
+    if (cellSize <= 0 || maxX <= minX || maxY <= minY)
+        throw cRuntimeError("Invalid search area or cellSize parameters");
+
+    // one task per cell, at its center
+    std::vector<CbbaAgent::Task> tasks;
+    for (double y = minY; y < maxY; y += cellSize)
+        for (double x = minX; x < maxX; x += cellSize)
+            tasks.push_back({std::min(x + cellSize / 2, (x + maxX) / 2), std::min(y + cellSize / 2, (y + maxY) / 2)});
+    if (tasks.size() > 0xFFFF)
+        throw cRuntimeError("Too many search cells (%d), the task id is 16 bits", (int)tasks.size());
+    return tasks;
+}
+
+void SwarmTaskAllocationApp::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg == timer) {
+        if (msg->getKind() == START)
+            startAllocation();
+        else if (isActive(simTime())) {
+            sendBids();
+            heartbeatInterval = std::min(2 * heartbeatInterval, maxHeartbeatInterval);
+            timer->setKind(BROADCAST);
+            if (isActive(simTime() + heartbeatInterval))
+                scheduleAfter(heartbeatInterval, timer);
+        }
+    }
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmTaskAllocationApp::startAllocation()
+{
+    // bids are computed from the position at the start of the allocation
+    Coord position = mobility->getCurrentPosition();
+    agent.setPosition(position.x, position.y);
+    started = true;
+    agent.buildBundle();
+    assignmentChanged();
+}
+
+void SwarmTaskAllocationApp::assignmentChanged()
+{
+    lastChange = simTime();
+    emit(assignmentChangeSignal, 1L);
+
+    // announce soon, then restart the heartbeat backoff
+    heartbeatInterval = minHeartbeatInterval;
+    simtime_t earliest = std::max(simTime(), lastBroadcast + minBroadcastInterval);
+    if (!isActive(earliest))
+        return;
+    if (!timer->isScheduled() || timer->getArrivalTime() > earliest) {
+        cancelEvent(timer);
+        timer->setKind(BROADCAST);
+        scheduleAt(earliest, timer);
+    }
+}
+
+void SwarmTaskAllocationApp::sendBids()
+{
+    simtime_t now = simTime();
+    std::vector<CbbaAgent::Bid> bids = agent.getBids();
+    const auto& timestamps = agent.getTimestamps();
+
+    const auto& chunk = makeShared<SwarmTaskBids>();
+    chunk->setSenderId(nodeId);
+    chunk->setBidsArraySize(bids.size());
+    chunk->setTimestampsArraySize(timestamps.size());
+    int length = varintLength(nodeId) + varintLength(bids.size()) + varintLength(timestamps.size());
+    for (size_t i = 0; i < bids.size(); i++) {
+        SwarmTaskBid bid;
+        bid.task = bids[i].task;
+        bid.winner = bids[i].winner;
+        bid.bid = bids[i].bid;
+        chunk->setBids(i, bid);
+        length += varintLength(bid.task) + varintLength(bid.winner) + 2;
+    }
+    size_t i = 0;
+    for (const auto& it : timestamps) {
+        SwarmAgentTimestamp timestamp;
+        timestamp.agent = it.first;
+        timestamp.time = it.second;
+        chunk->setTimestamps(i++, timestamp);
+        length += varintLength(it.first) + varintLength((uint64_t)std::llround((now.dbl() - it.second) * 1000));
+    }
+    chunk->setChunkLength(B(length));
+
+    auto packet = new Packet("SwarmTaskBids", chunk);
+    packet->addTag<HopLimitReq>()->setHopLimit(1);    // consensus is neighbor to neighbor
+    emit(bidsSentSignal, packet);
+    socket.sendTo(packet, destAddress, port);
+    lastBroadcast = now;
+}
+
+void SwarmTaskAllocationApp::processBids(const Ptr<const SwarmTaskBids>& chunk)
+{
+    uint32_t sender = chunk->getSenderId();
+    std::vector<CbbaAgent::Bid> bids;
+    Neighbor& neighbor = neighbors[sender];
+    neighbor.winners.assign(agent.getNumTasks(), CbbaAgent::NONE);
+    neighbor.lastHeard = simTime();
+    for (size_t i = 0; i < chunk->getBidsArraySize(); i++) {
+        const SwarmTaskBid& bid = chunk->getBids(i);
+        bids.push_back({bid.task, (int)bid.winner, bid.bid});
+        if (bid.task < neighbor.winners.size())
+            neighbor.winners[bid.task] = bid.winner;
+    }
+    std::unordered_map<int, double> timestamps;
+    for (size_t i = 0; i < chunk->getTimestampsArraySize(); i++) {
+        const SwarmAgentTimestamp& timestamp = chunk->getTimestamps(i);
+        timestamps[timestamp.agent] = timestamp.time.dbl();
+    }
+
+    bool changed = agent.merge(sender, bids, timestamps, simTime().dbl());
+    changed |= agent.buildBundle();
+    if (changed)
+        assignmentChanged();
+}
+
+void SwarmTaskAllocationApp::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    emit(bidsReceivedSignal, packet);
+    const auto& chunk = packet->peekAtFront<SwarmTaskBids>();
+    if (started && chunk->getSenderId() != nodeId)
+        processBids(chunk);
+    delete packet;
+}
+
+void SwarmTaskAllocationApp::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmTaskAllocationApp::finish()
+{
+    if (started) {
+        const std::vector<int>& winners = agent.getWinners();
+        int assigned = std::count_if(winners.begin(), winners.end(), [] (int winner) { return winner != CbbaAgent::NONE; });
+        int disagreements = 0;
+        simtime_t since = simTime() - maxHeartbeatInterval;
+        for (const auto& it : neighbors) {
+            if (it.second.lastHeard < since)
+                continue;
+            for (size_t j = 0; j < winners.size(); j++)
+                if (it.second.winners[j] != winners[j])
+                    disagreements++;
+        }
+        recordScalar("convergenceTime", lastChange - startTime, "s");
+        recordScalar("bundleSize", agent.getBundle().size());
+        recordScalar("bundleScore", agent.getBundleScore());
+        recordScalar("assignedTasks", assigned);
+        recordScalar("disagreements", disagreements);
+    }
+
+    ApplicationBase::finish();
+}
+
+void SwarmTaskAllocationApp::handleStartOperation(LifecycleOperation *operation)
+{
+    NetworkInterface *ie = interfaceTable->findInterfaceByName(par("interfaceName"));
+    if (ie == nullptr)
+        throw cRuntimeError("Interface '%s' not found", par("interfaceName").stringValue());
+    destAddress = L3AddressResolver().resolve(par("destAddress"));
+
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), port);
+    socket.setMulticastOutputInterface(ie->getInterfaceId());
+    socket.setMulticastLoop(false);
+
+    simtime_t start = std::max(startTime, simTime());
+    if (isActive(start)) {
+        timer->setKind(START);
+        scheduleAt(start, timer);
+    }
+}
+
+void SwarmTaskAllocationApp::handleStopOperation(LifecycleOperation *operation)
+{
+    cancelEvent(timer);
+    socket.close();
+}
+
+void SwarmTaskAllocationApp::handleCrashOperation(LifecycleOperation *operation)
+{
+    cancelEvent(timer);
+    socket.destroy();
+}
+
+} // namespace droneswarm
@@ -0,0 +1,92 @@
+//===================================================================================
+// SWARM TASK ALLOCATION APP - CBBA auction of SAR search cells
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMTASKALLOCATIONAPP_H
+#define __DRONESWARM_SWARMTASKALLOCATIONAPP_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "tasking/CbbaAgent.h"
+#include "tasking/SwarmTasking_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmTaskAllocationApp : public ApplicationBase, public UdpSocket::ICallback
+{
+  protected:
+    enum SelfMsgKinds { START = 1, BROADCAST };
+
+    struct Neighbor
+    {
+        std::vector<int> winners;   // dense, from its last frame
+        simtime_t lastHeard;
+    };
+
+    // parameters
+    uint32_t nodeId = 0;
+    L3Address destAddress;
+    int port = -1;
+    simtime_t startTime;
+    simtime_t stopTime;
+    simtime_t minBroadcastInterval;
+    simtime_t minHeartbeatInterval;
+    simtime_t maxHeartbeatInterval;
+
+    // context
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    ModuleRefByPar<IMobility> mobility;
+    UdpSocket socket;
+    cMessage *timer = nullptr;
+
+    // state
+    CbbaAgent agent;
+    bool started = false;
+    simtime_t lastBroadcast;
+    simtime_t heartbeatInterval;
+    simtime_t lastChange;
+    std::unordered_map<uint32_t, Neighbor> neighbors;
+
+    static simsignal_t bidsSentSignal;
+    static simsignal_t bidsReceivedSignal;
+    static simsignal_t assignmentChangeSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+    virtual void finish() override;
+
+    std::vector<CbbaAgent::Task> createTasks() const;
+    void startAllocation();
+    void sendBids();
+    void processBids(const Ptr<const SwarmTaskBids>& bids);
+    void assignmentChanged();
+    bool isActive(simtime_t t) const { return stopTime < SIMTIME_ZERO || t < stopTime; }
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmTaskAllocationApp();
+};
+
+} // namespace droneswarm
+
+#endif
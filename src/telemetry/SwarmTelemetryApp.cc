@@ -0,0 +1,489 @@
+//===================================================================================
+// SWARM TELEMETRY APP - Position/velocity/status telemetry with AoI statistics
+//===================================================================================
+
+#include "telemetry/SwarmTelemetryApp.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "inet/common/Simsignals.h"
+#include "inet/linklayer/common/InterfaceTag_m.h"
+#include "inet/networklayer/common/HopLimitTag_m.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+
+#include "clustering/SwarmClustering.h"
+#include "telemetry/TelemetryCodec.h"
+
+namespace droneswarm {
+
+Define_Module(SwarmTelemetryApp);
+
+simsignal_t SwarmTelemetryApp::peakAgeSignal = cComponent::registerSignal("peakAge");
+simsignal_t SwarmTelemetryApp::updateDelaySignal = cComponent::registerSignal("updateDelay");
+simsignal_t SwarmTelemetryApp::staleUpdateSignal = cComponent::registerSignal("staleUpdate");
+simsignal_t SwarmTelemetryApp::sendRateSignal = cComponent::registerSignal("sendRate");
+simsignal_t SwarmTelemetryApp::channelBusyRatioSignal = cComponent::registerSignal("channelBusyRatio");
+simsignal_t SwarmTelemetryApp::oneHopNeighborsSignal = cComponent::registerSignal("oneHopNeighbors");
+simsignal_t SwarmTelemetryApp::aggregateSentSignal = cComponent::registerSignal("aggregateSent");
+simsignal_t SwarmTelemetryApp::aggregatedEntriesSignal = cComponent::registerSignal("aggregatedEntries");
+simsignal_t SwarmTelemetryApp::undecodableAggregateSignal = cComponent::registerSignal("undecodableAggregate");
+
+SwarmTelemetryApp::~SwarmTelemetryApp()
+{
+    cancelAndDelete(selfMsg);
+    cancelAndDelete(rateControlTimer);
+    cancelAndDelete(aggregateTimer);
+}
+
+void SwarmTelemetryApp::initialize(int stage)
+{
+    ApplicationBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        transmit = par("transmit");
+        nodeId = par("nodeId");
+        port = par("port");
+        startTime = par("startTime");
+        stopTime = par("stopTime");
+        if (stopTime >= SIMTIME_ZERO && stopTime < startTime)
+            throw cRuntimeError("Invalid startTime/stopTime parameters");
+        timeToLive = par("timeToLive");
+        neighborValidity = par("neighborValidity");
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        if (transmit)
+            mobility.reference(this, "mobilityModule", true);
+        sources.resize(par("initialTableSize").intValue());
+        selfMsg = new cMessage("TelemetryTimer");
+
+        adaptiveRate = par("adaptiveRate");
+        if (adaptiveRate) {
+            minRate = par("minRate");
+            maxRate = par("maxRate");
+            targetBusyRatio = par("targetBusyRatio");
+            alpha = par("alpha");
+            beta = par("beta");
+            frameAirtime = par("frameAirtime");
+            rateControlInterval = par("rateControlInterval");
+            if (minRate <= 0 || maxRate < minRate)
+                throw cRuntimeError("Invalid minRate/maxRate parameters");
+            rate = maxRate;
+            cModule *radioModule = getModuleByPath(par("radioModule"));
+            radio = check_and_cast<physicallayer::IRadio *>(radioModule);
+            radioModule->subscribe(physicallayer::IRadio::receptionStateChangedSignal, this);
+            radioModule->subscribe(physicallayer::IRadio::transmissionStateChangedSignal, this);
+            rateControlTimer = new cMessage("RateControlTimer", RATE_CONTROL);
+        }
+
+        const char *clusteringModule = par("clusteringModule");
+        if (clusteringModule[0]) {
+            clustering = check_and_cast<SwarmClustering *>(getModuleByPath(clusteringModule));
+            clustering->setNodeId(nodeId);
+        }
+
+        aggregate = par("aggregate");
+        if (aggregate) {
+            aggregationInterval = par("aggregationInterval");
+            maxAggregatedAge = par("maxAggregatedAge");
+            keyFrameInterval = par("keyFrameInterval");
+            maxAggregatedEntries = par("maxAggregatedEntries");
+            aggregateTimer = new cMessage("AggregateTimer", AGGREGATE);
+        }
+    }
+}
+
+void SwarmTelemetryApp::handleMessageWhenUp(cMessage *msg)
+{
+    if (msg->isSelfMessage()) {
+        switch (msg->getKind()) {
+            case START:
+            case SEND:
+                sendTelemetry();
+                scheduleNextSend();
+                break;
+            case STOP:
+                break;
+            case RATE_CONTROL:
+                updateRate();
+                break;
+            case AGGREGATE:
+                sendAggregate();
+                if (stopTime < SIMTIME_ZERO || simTime() + aggregationInterval < stopTime)
+                    scheduleAfter(aggregationInterval, aggregateTimer);
+                break;
+            default:
+                throw cRuntimeError("Invalid kind %d in self message", (int)msg->getKind());
+        }
+    }
+    else if (socket.belongsToSocket(msg))
+        socket.processMessage(msg);
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SwarmTelemetryApp::scheduleNextSend()
+{
+    simtime_t next = simTime();
+    if (adaptiveRate)
+        next += exponential(1 / rate);
+    else
+        next += par("sendInterval");
+    if (stopTime < SIMTIME_ZERO || next < stopTime) {
+        selfMsg->setKind(SEND);
+        scheduleAt(next, selfMsg);
+    }
+    else {
+        selfMsg->setKind(STOP);
+        scheduleAt(stopTime, selfMsg);
+    }
+}
+
+void SwarmTelemetryApp::updateChannelBusy()
+{
+    using physicallayer::IRadio;
+    bool busy = radio->getTransmissionState() == IRadio::TRANSMISSION_STATE_TRANSMITTING ||
+                radio->getReceptionState() == IRadio::RECEPTION_STATE_BUSY ||
+                radio->getReceptionState() == IRadio::RECEPTION_STATE_RECEIVING;
+    if (busy == channelBusy)
+        return;
+    if (channelBusy)
+        busyTime += simTime() - busySince;
+    else
+        busySince = simTime();
+    channelBusy = busy;
+}
+
+void SwarmTelemetryApp::receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details)
+{
+    Enter_Method_Silent();
+    updateChannelBusy();
+}
+
+int SwarmTelemetryApp::countOneHopNeighbors() const
+{
+    simtime_t since = simTime() - neighborValidity;
+    int count = 0;
+    for (const auto& source : sources)
+        if (source.valid && source.lastHeardDirect > SIMTIME_ZERO && source.lastHeardDirect >= since)
+            count++;
+    return count;
+}
+
+void SwarmTelemetryApp::updateRate()
+{
+    simtime_t now = simTime();
+    if (channelBusy) {
+        busyTime += now - busySince;
+        busySince = now;
+    }
+    double sample = (busyTime / rateControlInterval).dbl();
+    busyTime = SIMTIME_ZERO;
+    busyRatio = (busyRatio + sample) / 2;   // CBR smoothing as in ETSI TS 102 687
+
+    // LIMERIC: linear convergence to the rate that meets the target busy ratio
+    rate = (1 - alpha) * rate + beta * (targetBusyRatio - busyRatio);
+
+    // density cap: every one-hop neighbor gets the same share of the target
+    int neighbors = countOneHopNeighbors();
+    double fairShare = targetBusyRatio / ((neighbors + 1) * frameAirtime.dbl());
+    rate = std::min(std::max(std::min(rate, fairShare), minRate), maxRate);
+
+    emit(channelBusyRatioSignal, busyRatio);
+    emit(oneHopNeighborsSignal, neighbors);
+    emit(sendRateSignal, rate);
+    scheduleAfter(rateControlInterval, rateControlTimer);
+}
+
+void SwarmTelemetryApp::sendTelemetry()
+{
+    Coord position = mobility->getCurrentPosition();
+    Coord velocity = mobility->getCurrentVelocity();
+
+    SwarmTelemetryState& state = own.state;
+    state.nodeId = nodeId;
+    state.generationTime = simTime();
+    state.position = position;
+    state.velocity = velocity;
+    state.heading = std::atan2(velocity.x, velocity.y);
+    state.pitch = std::atan2(velocity.z, std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y));
+    state.sequence = sequence++;
+    state.flags = position.z > 0 ? SWARM_TELEMETRY_AIRBORNE : 0;
+    own.valid = true;
+
+    const auto& telemetry = makeShared<SwarmTelemetry>();
+    telemetry->setState(state);
+    telemetry->setInitialTtl(timeToLive);
+    if (clustering != nullptr) {
+        clustering->update(velocity);
+        telemetry->setClusterHead(clustering->getClusterHead());
+        telemetry->setClusterWeight(clustering->getWeight());
+        telemetry->setChunkLength(B(55));
+    }
+    auto packet = new Packet("SwarmTelemetry", telemetry);
+    emit(packetSentSignal, packet);
+    sendToGroup(packet);
+}
+
+void SwarmTelemetryApp::sendAggregate()
+{
+    if (clustering != nullptr && !clustering->isAggregator()) {
+        // plain cluster member: telemetry stays local, resume with a key frame
+        lastKeyFrame = SIMTIME_ZERO;
+        return;
+    }
+
+    simtime_t now = simTime();
+    bool keyFrame = lastKeyFrame == SIMTIME_ZERO || now - lastKeyFrame >= keyFrameInterval;
+    if (keyFrame) {
+        // receivers that lost a frame resynchronize on entries encoded against zero
+        lastKeyFrame = now;
+        own.aggregated = false;
+        for (auto& source : sources)
+            source.aggregated = false;
+    }
+
+    // states that changed since they were last aggregated and are still fresh
+    std::vector<SourceState *> candidates;
+    auto consider = [&] (SourceState& source) {
+        if (source.valid && now - source.state.generationTime <= maxAggregatedAge &&
+                (!source.aggregated || source.state.generationTime > source.lastAggregated.generationTime))
+            candidates.push_back(&source);
+    };
+    consider(own);
+    for (auto& source : sources)
+        consider(source);
+    if (candidates.empty())
+        return;
+    if ((int)candidates.size() > maxAggregatedEntries) {
+        std::partial_sort(candidates.begin(), candidates.begin() + maxAggregatedEntries, candidates.end(),
+                [] (const SourceState *a, const SourceState *b) { return a->state.generationTime > b->state.generationTime; });
+        candidates.resize(maxAggregatedEntries);
+    }
+
+    const auto& aggregateChunk = makeShared<SwarmTelemetryAggregate>();
+    aggregateChunk->setSenderId(nodeId);
+    aggregateChunk->setSequence(aggregateSequence++);
+    aggregateChunk->setKeyFrame(keyFrame);
+    aggregateChunk->setEntriesArraySize(candidates.size());
+    B length = TelemetryCodec::headerLength(nodeId, candidates.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+        SourceState *source = candidates[i];
+        aggregateChunk->setEntries(i, source->state);
+        length += TelemetryCodec::entryLength(source->state, source->aggregated ? &source->lastAggregated : nullptr);
+        source->aggregated = true;
+        source->lastAggregated = source->state;
+    }
+    aggregateChunk->setChunkLength(length);
+
+    auto packet = new Packet("SwarmTelemetryAggregate", aggregateChunk);
+    packet->addTag<HopLimitReq>()->setHopLimit(1);   // re-aggregated at every hop
+    emit(aggregatedEntriesSignal, (long)candidates.size());
+    emit(aggregateSentSignal, packet);
+    sendToGroup(packet);
+}
+
+void SwarmTelemetryApp::sendToGroup(Packet *packet)
+{
+    // one copy per output interface: a gateway bridges the channels of its radios
+    for (size_t i = 1; i < outputInterfaceIds.size(); i++) {
+        Packet *copy = packet->dup();
+        copy->addTag<InterfaceReq>()->setInterfaceId(outputInterfaceIds[i]);
+        socket.sendTo(copy, destAddress, port);
+    }
+    if (!outputInterfaceIds.empty())
+        packet->addTag<InterfaceReq>()->setInterfaceId(outputInterfaceIds[0]);
+    socket.sendTo(packet, destAddress, port);
+}
+
+SwarmTelemetryApp::SourceState& SwarmTelemetryApp::getSourceSlot(uint32_t id)
+{
+    if (id >= sources.size())
+        sources.resize(std::max<size_t>(id + 1, 2 * sources.size()));
+    return sources[id];
+}
+
+void SwarmTelemetryApp::updateSource(const SwarmTelemetryState& state, bool countGaps)
+{
+    simtime_t now = simTime();
+    simtime_t generated = state.generationTime;
+    SourceState& source = getSourceSlot(state.nodeId);
+    if (!source.valid) {
+        source.valid = true;
+        source.firstReceived = now;
+        numSources++;
+    }
+    else if (generated <= source.state.generationTime) {
+        // relayed copy overtaken by a fresher one
+        emit(staleUpdateSignal, 1L);
+        return;
+    }
+    else {
+        // AoI grows linearly from lastReceived until now, then drops
+        simtime_t lastGenerated = source.state.generationTime;
+        double ageBefore = (source.lastReceived - lastGenerated).dbl();
+        double peakAge = (now - lastGenerated).dbl();
+        source.ageArea += (peakAge * peakAge - ageBefore * ageBefore) / 2;
+        emit(peakAgeSignal, now - lastGenerated);
+        if (countGaps) {
+            uint16_t gap = state.sequence - source.state.sequence;
+            source.lost += gap - 1;
+        }
+    }
+    emit(updateDelaySignal, now - generated);
+    source.state = state;
+    source.lastReceived = now;
+    source.received++;
+}
+
+void SwarmTelemetryApp::processTelemetry(Packet *packet)
+{
+    emit(packetReceivedSignal, packet);
+    const auto& chunk = packet->peekAtFront<Chunk>();
+    if (auto aggregateChunk = dynamicPtrCast<const SwarmTelemetryAggregate>(chunk))
+        processAggregate(aggregateChunk);
+    else {
+        const auto& telemetry = packet->peekAtFront<SwarmTelemetry>();
+        const SwarmTelemetryState& state = telemetry->getState();
+        auto hopLimitInd = packet->findTag<HopLimitInd>();
+        if (hopLimitInd != nullptr && hopLimitInd->getHopLimit() == telemetry->getInitialTtl()) {
+            getSourceSlot(state.nodeId).lastHeardDirect = simTime();   // relays decrement the TTL
+            if (clustering != nullptr)
+                clustering->neighborHeard(state.nodeId, telemetry->getClusterHead(), telemetry->getClusterWeight(), state.velocity);
+        }
+        updateSource(state, true);
+    }
+    delete packet;
+}
+
+void SwarmTelemetryApp::processAggregate(const Ptr<const SwarmTelemetryAggregate>& aggregateChunk)
+{
+    // deltas are only decodable if no frame of this sender was lost since its last key frame
+    SourceState& sender = getSourceSlot(aggregateChunk->getSenderId());
+    uint16_t frameSequence = aggregateChunk->getSequence();
+    sender.aggregateSynced = aggregateChunk->getKeyFrame() ||
+            (sender.aggregateSynced && (uint16_t)(frameSequence - sender.lastAggregateSequence) == 1);
+    sender.lastAggregateSequence = frameSequence;
+    if (!sender.aggregateSynced) {
+        emit(undecodableAggregateSignal, 1L);
+        return;
+    }
+    for (size_t i = 0; i < aggregateChunk->getEntriesArraySize(); i++) {
+        const SwarmTelemetryState& state = aggregateChunk->getEntries(i);
+        if (!transmit || state.nodeId != nodeId)
+            updateSource(state, false);     // aggregation skips intermediate states
+    }
+}
+
+void SwarmTelemetryApp::socketDataArrived(UdpSocket *socket, Packet *packet)
+{
+    processTelemetry(packet);
+}
+
+void SwarmTelemetryApp::socketErrorArrived(UdpSocket *socket, Indication *indication)
+{
+    EV_WARN << "Ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void SwarmTelemetryApp::finish()
+{
+    simtime_t now = simTime();
+    double ageArea = 0;
+    double observed = 0;
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    for (const auto& source : sources) {
+        if (!source.valid)
+            continue;
+        double ageBefore = (source.lastReceived - source.state.generationTime).dbl();
+        double ageNow = (now - source.state.generationTime).dbl();
+        ageArea += source.ageArea + (ageNow * ageNow - ageBefore * ageBefore) / 2;
+        observed += (now - source.firstReceived).dbl();
+        received += source.received;
+        lost += source.lost;
+    }
+    recordScalar("trackedSources", numSources);
+    if (observed > 0)
+        recordScalar("meanAgeOfInformation", ageArea / observed, "s");
+    if (received + lost > 0)
+        recordScalar("updateLossRatio", (double)lost / (received + lost));
+
+    ApplicationBase::finish();
+}
+
+void SwarmTelemetryApp::refreshDisplay() const
+{
+    ApplicationBase::refreshDisplay();
+
+    char buf[40];
+    sprintf(buf, "sources: %d", numSources);
+    getDisplayString().setTagArg("t", 0, buf);
+}
+
+void SwarmTelemetryApp::handleStartOperation(LifecycleOperation *operation)
+{
+    destAddress = L3AddressResolver().resolve(par("destAddress"));
+
+    socket.setOutputGate(gate("socketOut"));
+    socket.setCallback(this);
+    socket.bind(L3Address(), port);
+    socket.setTimeToLive(par("timeToLive"));
+    socket.setMulticastLoop(false);
+    outputInterfaceIds.clear();
+    const char *multicastInterface = par("multicastInterface");
+    if (multicastInterface[0]) {
+        cPatternMatcher matcher(multicastInterface, false, true, true);
+        for (int i = 0; i < interfaceTable->getNumInterfaces(); i++) {
+            NetworkInterface *ie = interfaceTable->getInterface(i);
+            if (matcher.matches(ie->getInterfaceName()))
+                outputInterfaceIds.push_back(ie->getInterfaceId());
+        }
+        if (outputInterfaceIds.empty())
+            throw cRuntimeError("Wrong multicastInterface setting: no interface matches \"%s\"", multicastInterface);
+    }
+
+    if (transmit) {
+        simtime_t start = std::max(startTime, simTime());
+        if (stopTime < SIMTIME_ZERO || start < stopTime) {
+            selfMsg->setKind(START);
+            scheduleAt(start, selfMsg);
+        }
+        if (adaptiveRate) {
+            rate = maxRate;
+            busyRatio = 0;
+            busyTime = SIMTIME_ZERO;
+            busySince = simTime();
+            channelBusy = false;
+            updateChannelBusy();
+            scheduleAfter(rateControlInterval, rateControlTimer);
+        }
+        if (aggregate) {
+            own.aggregated = false;
+            lastKeyFrame = SIMTIME_ZERO;
+            if (stopTime < SIMTIME_ZERO || start + aggregationInterval < stopTime)
+                scheduleAt(start + aggregationInterval, aggregateTimer);
+        }
+    }
+}
+
+void SwarmTelemetryApp::handleStopOperation(LifecycleOperation *operation)
+{
+    cancelEvent(selfMsg);
+    if (rateControlTimer != nullptr)
+        cancelEvent(rateControlTimer);
+    if (aggregateTimer != nullptr)
+        cancelEvent(aggregateTimer);
+    socket.close();
+}
+
+void SwarmTelemetryApp::handleCrashOperation(LifecycleOperation *operation)
+{
+    cancelEvent(selfMsg);
+    if (rateControlTimer != nullptr)
+        cancelEvent(rateControlTimer);
+    if (aggregateTimer != nullptr)
+        cancelEvent(aggregateTimer);
+    socket.destroy();
+}
+
+} // namespace droneswarm
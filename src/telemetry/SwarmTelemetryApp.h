@@ -0,0 +1,158 @@
+//===================================================================================
+// SWARM TELEMETRY APP - Position/velocity/status telemetry with AoI statistics
+//===================================================================================
+
+#ifndef __DRONESWARM_SWARMTELEMETRYAPP_H
+#define __DRONESWARM_SWARMTELEMETRYAPP_H
+
+#include <vector>
+
+#include "inet/applications/base/ApplicationBase.h"
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+#include "inet/transportlayer/contract/udp/UdpSocket.h"
+
+#include "telemetry/SwarmTelemetry_m.h"
+
+namespace droneswarm {
+
+using namespace inet;
+
+class SwarmClustering;
+
+class SwarmTelemetryApp : public ApplicationBase, public UdpSocket::ICallback, public cListener
+{
+  public:
+    /** Latest known state of one source; table slot = nodeId. */
+    struct SourceState
+    {
+        bool valid = false;
+        SwarmTelemetryState state;  // freshest state
+        simtime_t lastReceived;
+        simtime_t lastHeardDirect;  // last copy received straight from the source
+        simtime_t firstReceived;    // start of the AoI integration
+        double ageArea = 0;         // integral of AoI since firstReceived, s^2
+        uint32_t received = 0;
+        uint32_t lost = 0;
+
+        // aggregation, as sender: delta reference of this source
+        bool aggregated = false;
+        SwarmTelemetryState lastAggregated;
+
+        // aggregation, as receiver: frames of this node decodable in sequence
+        bool aggregateSynced = false;
+        uint16_t lastAggregateSequence = 0;
+    };
+
+  protected:
+    enum SelfMsgKinds { START = 1, SEND, STOP, RATE_CONTROL, AGGREGATE };
+
+    // parameters
+    bool transmit = true;
+    uint32_t nodeId = 0;
+    L3Address destAddress;
+    int port = -1;
+    simtime_t startTime;
+    simtime_t stopTime;
+    int timeToLive = -1;
+
+    // adaptive rate control (DCC-style)
+    bool adaptiveRate = false;
+    double minRate = 0;
+    double maxRate = 0;
+    double targetBusyRatio = 0;
+    double alpha = 0;
+    double beta = 0;
+    simtime_t frameAirtime;
+    simtime_t rateControlInterval;
+    simtime_t neighborValidity;
+
+    // aggregated relay
+    bool aggregate = false;
+    simtime_t aggregationInterval;
+    simtime_t maxAggregatedAge;
+    simtime_t keyFrameInterval;
+    int maxAggregatedEntries = 0;
+
+    // context
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    ModuleRefByPar<IMobility> mobility;
+    physicallayer::IRadio *radio = nullptr;
+    SwarmClustering *clustering = nullptr;
+    UdpSocket socket;
+    std::vector<int> outputInterfaceIds;    // matching multicastInterface
+    cMessage *selfMsg = nullptr;
+    cMessage *rateControlTimer = nullptr;
+    cMessage *aggregateTimer = nullptr;
+
+    // state
+    uint16_t sequence = 0;
+    std::vector<SourceState> sources;
+    int numSources = 0;
+    SourceState own;                // own state and its delta reference
+    uint16_t aggregateSequence = 0;
+    simtime_t lastKeyFrame;
+    double rate = 0;                // current telemetry rate, Hz
+    double busyRatio = 0;           // smoothed channel busy ratio
+    bool channelBusy = false;
+    simtime_t busySince;
+    simtime_t busyTime;             // busy time in the current rate control interval
+
+    static simsignal_t peakAgeSignal;
+    static simsignal_t updateDelaySignal;
+    static simsignal_t staleUpdateSignal;
+    static simsignal_t sendRateSignal;
+    static simsignal_t channelBusyRatioSignal;
+    static simsignal_t oneHopNeighborsSignal;
+    static simsignal_t aggregateSentSignal;
+    static simsignal_t aggregatedEntriesSignal;
+    static simsignal_t undecodableAggregateSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessageWhenUp(cMessage *msg) override;
+    virtual void finish() override;
+    virtual void refreshDisplay() const override;
+
+    virtual void sendTelemetry();
+    virtual void processTelemetry(Packet *packet);
+    virtual void sendAggregate();
+    void sendToGroup(Packet *packet);
+    virtual void processAggregate(const Ptr<const SwarmTelemetryAggregate>& aggregate);
+    SourceState& getSourceSlot(uint32_t id);
+    void updateSource(const SwarmTelemetryState& state, bool countGaps);
+    virtual void scheduleNextSend();
+    virtual void updateRate();
+    void updateChannelBusy();
+    int countOneHopNeighbors() const;
+
+    // cListener
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details) override;
+
+    // lifecycle
+    virtual void handleStartOperation(LifecycleOperation *operation) override;
+    virtual void handleStopOperation(LifecycleOperation *operation) override;
+    virtual void handleCrashOperation(LifecycleOperation *operation) override;
+
+    // UdpSocket::ICallback
+    virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
+    virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
+    virtual void socketClosed(UdpSocket *socket) override {}
+
+  public:
+    virtual ~SwarmTelemetryApp();
+
+    /** State of the given source, or nullptr if nothing was heard from it. */
+    const SourceState *findSource(uint32_t id) const { return id < sources.size() && sources[id].valid ? &sources[id] : nullptr; }
+    int getNumSources() const { return numSources; }
+    uint32_t getNodeId() const { return nodeId; }
+    /** Source ids are below this bound. */
+    int getSourceTableSize() const { return sources.size(); }
+};
+
+} // namespace droneswarm
+
+#endif
@@ -0,0 +1,14 @@
+//===================================================================================
+// INETDEFS STUB - Just enough of INET for TransmissionIndex.h outside a simulation
+//===================================================================================
+
+#ifndef __DRONESWARM_BENCH_INETDEFS_H
+#define __DRONESWARM_BENCH_INETDEFS_H
+
+namespace omnetpp {
+
+typedef double simtime_t;
+
+} // namespace omnetpp
+
+#endif
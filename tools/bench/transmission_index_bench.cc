@@ -0,0 +1,221 @@
+//===================================================================================
+// TRANSMISSION INDEX BENCHMARK - Index vs. linear scan outside the simulator
+//===================================================================================
+// Replays the interference lookups of the radio medium for the DroneSwarm5km
+// telemetry pattern (4 km x 4 km, 50-120 m altitude, 10 Hz exponential send
+// intervals) at 10x its swarm size, once against TransmissionIndex and once
+// against a linear scan of the live transmissions kept the way
+// VectorCommunicationCache keeps them, and reports the speed-up. Both must
+// find the same interferers; a mismatch fails the run.
+//
+//   Every frame is added at its start, queried by each radio within the
+//   communication range at its reception end, and removed at its
+//   interference end time: the medium keeps a transmission until no
+//   reception it overlaps can still be evaluated, i.e. end + propagation
+//   + maxTransmissionDuration (MediumLimitCache default 10 ms).
+//
+// Build and run from the repository root (only TransmissionIndex.h and the
+// simtime stub in tools/bench are needed):
+//
+//   c++ -O2 -std=c++17 -Itools/bench -Isrc tools/bench/transmission_index_bench.cc -o transmission_index_bench
+//   ./transmission_index_bench [drones=100] [seconds=60] [airtime_us=200]
+//===================================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "physical/TransmissionIndex.h"
+
+using namespace droneswarm;
+
+namespace {
+
+const double AREA = 4000;                   // m, DroneSwarm5km constraint area
+const double COMMUNICATION_RANGE = 700;     // m, maxCommunicationRange
+const double INTERFERENCE_RANGE = 1200;     // m, maxInterferenceRange
+const double PROPAGATION_SPEED = 299792458;
+const double MAX_PROPAGATION_DELAY = INTERFERENCE_RANGE / PROPAGATION_SPEED;
+const double MAX_TRANSMISSION_DURATION = 0.01;  // MediumLimitCache default
+const double BUCKET_DURATION = 0.001;       // bucketDuration default
+
+struct Transmission
+{
+    int id;
+    double start;
+    double end;
+};
+
+struct Event
+{
+    enum Kind { ADD, QUERY, REMOVE };
+
+    double time;
+    Kind kind;
+    int transmission;
+    int radio;
+
+    bool operator>(const Event& other) const { return time > other.time || (time == other.time && kind > other.kind); }
+};
+
+struct Workload
+{
+    std::vector<Transmission> transmissions;
+    std::vector<Event> events;               // in time order
+};
+
+Workload generate(int drones, double duration, double airtime)
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> horizontal(0, AREA), altitude(50, 120);
+    std::exponential_distribution<double> interval(10);
+    struct Position { double x, y, z; };
+    std::vector<Position> positions(drones);
+    for (auto& position : positions)
+        position = {horizontal(rng), horizontal(rng), altitude(rng)};
+
+    // ids in start order, as the medium assigns them
+    std::vector<std::pair<double, int>> starts;
+    for (int sender = 0; sender < drones; sender++)
+        for (double time = interval(rng); time < duration; time += interval(rng))
+            starts.push_back({time, sender});
+    std::sort(starts.begin(), starts.end());
+
+    Workload workload;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> queue;
+    for (const auto& start : starts) {
+        int id = workload.transmissions.size();
+        workload.transmissions.push_back({id, start.first, start.first + airtime});
+        queue.push({start.first, Event::ADD, id, start.second});
+    }
+    while (!queue.empty()) {
+        Event event = queue.top();
+        queue.pop();
+        workload.events.push_back(event);
+        if (event.kind != Event::ADD)
+            continue;
+        const Transmission& transmission = workload.transmissions[event.transmission];
+        const Position& from = positions[event.radio];
+        for (int radio = 0; radio < drones; radio++) {
+            const Position& to = positions[radio];
+            double distance = std::sqrt((to.x - from.x) * (to.x - from.x) + (to.y - from.y) * (to.y - from.y) + (to.z - from.z) * (to.z - from.z));
+            if (radio != event.radio && distance <= COMMUNICATION_RANGE)
+                queue.push({transmission.end + distance / PROPAGATION_SPEED, Event::QUERY, transmission.id, radio});
+        }
+        queue.push({transmission.end + MAX_PROPAGATION_DELAY + MAX_TRANSMISSION_DURATION, Event::REMOVE, transmission.id, -1});
+    }
+    return workload;
+}
+
+// VectorCommunicationCache: entries by id, popped from the front once removed
+class LinearScan
+{
+  protected:
+    std::deque<const Transmission *> entries;
+    int baseId = 0;
+
+  public:
+    void add(const Transmission *transmission)
+    {
+        if (entries.empty())
+            baseId = transmission->id;
+        entries.resize(transmission->id - baseId + 1, nullptr);
+        entries[transmission->id - baseId] = transmission;
+    }
+
+    void remove(int id)
+    {
+        entries[id - baseId] = nullptr;
+        while (!entries.empty() && entries.front() == nullptr) {
+            entries.pop_front();
+            baseId++;
+        }
+    }
+
+    template <typename F>
+    void query(double from, double to, F f) const
+    {
+        for (const Transmission *transmission : entries)
+            if (transmission != nullptr && !(transmission->end < from || to < transmission->start))
+                f(transmission);
+    }
+};
+
+class Indexed
+{
+  protected:
+    TransmissionIndex<const Transmission *> index{BUCKET_DURATION};
+
+  public:
+    void add(const Transmission *transmission) { index.add(transmission->id, transmission->start, transmission->end, transmission); }
+    void remove(int id) { index.remove(id); }
+
+    template <typename F>
+    void query(double from, double to, F f) const { index.query(from, to, f); }
+};
+
+template <typename Cache>
+double replay(const Workload& workload, long& numInterferers, long& checksum)
+{
+    Cache cache;
+    numInterferers = 0;
+    checksum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (const Event& event : workload.events) {
+        const Transmission& transmission = workload.transmissions[event.transmission];
+        switch (event.kind) {
+            case Event::ADD:
+                cache.add(&transmission);
+                break;
+            case Event::QUERY:
+            {
+                // the reception's [start, end], as SwarmIndexedCommunicationCache queries it
+                double receptionStart = event.time - (transmission.end - transmission.start);
+                cache.query(receptionStart - MAX_PROPAGATION_DELAY, event.time, [&] (const Transmission *other) {
+                    if (other != &transmission) {
+                        numInterferers++;
+                        checksum += (long)other->id * (event.radio + 1);
+                    }
+                });
+                break;
+            }
+            case Event::REMOVE:
+                cache.remove(transmission.id);
+                break;
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int drones = argc > 1 ? std::atoi(argv[1]) : 100;
+    double duration = argc > 2 ? std::atof(argv[2]) : 60;
+    double airtime = (argc > 3 ? std::atof(argv[3]) : 200) * 1e-6;
+
+    Workload workload = generate(drones, duration, airtime);
+    long numQueries = std::count_if(workload.events.begin(), workload.events.end(), [] (const Event& event) { return event.kind == Event::QUERY; });
+    std::printf("%d drones, %g s, %g us frames: %zu transmissions, %ld lookups\n",
+            drones, duration, airtime * 1e6, workload.transmissions.size(), numQueries);
+
+    long linearInterferers, linearChecksum, indexedInterferers, indexedChecksum;
+    double linear = replay<LinearScan>(workload, linearInterferers, linearChecksum);
+    double indexed = replay<Indexed>(workload, indexedInterferers, indexedChecksum);
+    std::printf("linear scan:        %8.3f s  (%ld interferers)\n", linear, linearInterferers);
+    std::printf("TransmissionIndex:  %8.3f s  (%ld interferers)\n", indexed, indexedInterferers);
+    if (linearInterferers != indexedInterferers || linearChecksum != indexedChecksum) {
+        std::printf("MISMATCH: the index and the linear scan found different interferers\n");
+        return 1;
+    }
+    std::printf("speed-up:           %8.2fx\n", linear / indexed);
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/bin/bash
+# Calibrate the statistical MAC: run the detailed LinkCalibration config and
+# fit link_table.xml from the per-link samples it records.
+#
+# Usage: tools/calibrate.sh [extra fit_link_table.py options]
+
+set -e
+
+export OMNETPP_ROOT="/Users/rodrigo/omnetpp-workspace/omnetpp-6.2.0"
+export INET_PROJ="/Users/rodrigo/omnetpp-workspace/inet-4.5.4"
+
+echo "==========================================="
+echo "Link Table Calibration"
+echo "==========================================="
+
+opp_env shell omnetpp-6.2.0 << EOF2
+cd /Users/rodrigo/omnetpp-workspace/drone-sar/simulations
+opp_runall -j4 ../out/clang-release/src/drone-sar -u Cmdenv -c LinkCalibration \
+    -n .:../src:\$INET_PROJ/src \
+    --ned-path=.:../src:\$INET_PROJ/src \
+    -l \$INET_PROJ/src/INET \
+    omnetpp.ini
+EOF2
+
+cd "$(dirname "$0")/.."
+python3 tools/fit_link_table.py "$@" simulations/results/LinkCalibration-*.links > link_table.xml
+echo "Wrote link_table.xml"
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Fit a SwarmStatisticalMac link table from SwarmLinkProbe logs.
+
+Usage:
+  fit_link_table.py [options] results/*.links > ../link_table.xml
+
+All logs must come from the same radio setup (identical headers); the
+table's version is the first 12 hex digits of the SHA-1 of that header,
+and the header itself is embedded in <radio>, so a table can always be
+traced back to (and regenerated from) the parameters it was fitted for.
+
+Broadcast and unicast samples are fitted separately; the unicast cells go
+to <unicast> (format version 1 logs hold broadcast samples only).
+
+Bins with fewer than --min-samples samples take the values of the nearest
+populated bin at the same altitude and load, searching towards shorter
+distances first; bins with nothing to borrow from never deliver.
+"""
+
+import argparse
+import bisect
+import hashlib
+import math
+import struct
+import sys
+
+RECORD = struct.Struct('<HhHBBI')
+
+
+def read_log(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'SWLK':
+        sys.exit('%s: not a link log' % path)
+    version, length = struct.unpack_from('<HI', data, 4)
+    if version not in (1, 2):
+        sys.exit('%s: unsupported format version %d' % (path, version))
+    header = data[10:10 + length].decode()
+    body = data[10 + length:]
+    if len(body) % RECORD.size:
+        sys.exit('%s: truncated' % path)
+    return header, RECORD.iter_unpack(body)
+
+
+def edges(text):
+    return [float(x) for x in text.split(',')]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('logs', nargs='+')
+    parser.add_argument('--distance', type=edges, default=edges('50,100,150,200,250,300,350,400,450,500,550,600,650,700'))
+    parser.add_argument('--altitude', type=edges, default=edges('10,25,50,70'))
+    parser.add_argument('--load', type=edges, default=edges('0,1,2,4,8,16,32'))
+    parser.add_argument('--min-samples', type=int, default=30)
+    args = parser.parse_args()
+
+    nd, na, nl = len(args.distance), len(args.altitude), len(args.load)
+    size = nd * na * nl
+    count = [[0] * size for _ in range(2)]          # [broadcast, unicast]
+    success = [[0] * size for _ in range(2)]
+    delay_sum = [[0.0] * size for _ in range(2)]
+    delay_square_sum = [[0.0] * size for _ in range(2)]
+
+    radio = None
+    for path in args.logs:
+        header, records = read_log(path)
+        if radio is None:
+            radio = header
+        elif header != radio:
+            sys.exit('%s: recorded with different radio parameters' % path)
+        for distance, altitude, load, ok, unicast, delay in records:
+            d = bisect.bisect_left(args.distance, distance / 10)
+            if d == nd:
+                continue
+            a = min(bisect.bisect_left(args.altitude, abs(altitude) / 10), na - 1)
+            l = min(bisect.bisect_left(args.load, load), nl - 1)
+            c = 1 if unicast else 0
+            i = (d * na + a) * nl + l
+            count[c][i] += 1
+            if ok:
+                success[c][i] += 1
+                delay_sum[c][i] += delay * 1e-6
+                delay_square_sum[c][i] += (delay * 1e-6) ** 2
+
+    def cell(c, i):
+        p = success[c][i] / count[c][i]
+        if success[c][i] == 0:
+            return p, 0.0, 0.0
+        mean = delay_sum[c][i] / success[c][i]
+        std = math.sqrt(max(delay_square_sum[c][i] / success[c][i] - mean * mean, 0))
+        return p, mean, std
+
+    def fit(c):
+        table = []
+        for d in range(nd):
+            for a in range(na):
+                for l in range(nl):
+                    fallback = (0.0, 0.0, 0.0)
+                    for dd in sorted(range(nd), key=lambda x: (abs(x - d), x > d)):
+                        i = (dd * na + a) * nl + l
+                        if count[c][i] >= args.min_samples:
+                            fallback = cell(c, i)
+                            break
+                    table.append(fallback)
+        return table
+
+    def print_cells(table, indent):
+        rows = lambda k, fmt: '\n'.join(indent + '    ' + ' '.join(fmt % table[r * nl + l][k] for l in range(nl)) for r in range(nd * na))
+        print('%s<success>\n%s\n%s</success>' % (indent, rows(0, '%.3f'), indent))
+        print('%s<delay>\n%s\n%s</delay>' % (indent, rows(1, '%.6f'), indent))
+        print('%s<delayStdDev>\n%s\n%s</delayStdDev>' % (indent, rows(2, '%.6f'), indent))
+
+    version = hashlib.sha1(radio.encode()).hexdigest()[:12]
+    print('<?xml version="1.0" encoding="UTF-8"?>')
+    print('<!-- Fitted by tools/fit_link_table.py from %d broadcast and %d unicast samples in %d logs -->'
+          % (sum(count[0]), sum(count[1]), len(args.logs)))
+    print('<linkTable version="%s">' % version)
+    print('    <radio>\n%s    </radio>' % ''.join('        %s\n' % line for line in radio.splitlines()).replace('&', '&amp;').replace('<', '&lt;'))
+    print('    <distance>%s</distance>' % ' '.join('%g' % x for x in args.distance))
+    print('    <altitude>%s</altitude>' % ' '.join('%g' % x for x in args.altitude))
+    print('    <load>%s</load>' % ' '.join('%g' % x for x in args.load))
+    print_cells(fit(0), '    ')
+    if sum(count[1]):
+        print('    <unicast>')
+        print_cells(fit(1), '        ')
+        print('    </unicast>')
+    print('</linkTable>')
+
+
+if __name__ == '__main__':
+    main()